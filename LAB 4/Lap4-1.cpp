@@ -6,28 +6,16 @@
 #include <queue>
 #include <algorithm>
 #include <iomanip>
+#include <cstdint>
 
-struct Process {
-    int pid;
-    int arrival_time;
-    int burst_time;
-    int remaining_time;
-    int completion_time;
-    int turnaround_time;
-    int waiting_time;
-    int priority;
-    
-    Process(int id, int at, int bt, int pr = 0) 
-        : pid(id), arrival_time(at), burst_time(bt), 
-          remaining_time(bt), priority(pr) {}
-};
+#include "process_table.h"
 
 class ProcessScheduler {
 public:
-    std::vector<Process> processes;
+    ProcessTable processes;
     
     void addProcess(int pid, int arrival, int burst, int priority = 0) {
-        processes.emplace_back(pid, arrival, burst, priority);
+        processes.add(pid, arrival, burst, priority);
     }
     
     void displayProcesses() {
@@ -36,25 +24,25 @@ public:
                   << std::setw(12) << "Turnaround" << std::setw(10) << "Waiting\n";
         std::cout << std::string(60, '-') << "\n";
         
-        for (const auto& p : processes) {
-            std::cout << std::setw(5) << p.pid << std::setw(10) << p.arrival_time
-                      << std::setw(10) << p.burst_time << std::setw(12) << p.completion_time
-                      << std::setw(12) << p.turnaround_time << std::setw(10) << p.waiting_time << "\n";
+        for (size_t i = 0; i < processes.size(); i++) {
+            std::cout << std::setw(5) << processes.pid[i] << std::setw(10) << processes.arrival_time[i]
+                      << std::setw(10) << processes.burst_time[i] << std::setw(12) << processes.completion_time[i]
+                      << std::setw(12) << processes.turnaroundTime(i) << std::setw(10) << processes.waitingTime(i) << "\n";
         }
     }
     
     double calculateAverageWaitingTime() {
         int total = 0;
-        for (const auto& p : processes) {
-            total += p.waiting_time;
+        for (size_t i = 0; i < processes.size(); i++) {
+            total += processes.waitingTime(i);
         }
         return static_cast<double>(total) / processes.size();
     }
     
     double calculateAverageTurnaroundTime() {
         int total = 0;
-        for (const auto& p : processes) {
-            total += p.turnaround_time;
+        for (size_t i = 0; i < processes.size(); i++) {
+            total += processes.turnaroundTime(i);
         }
         return static_cast<double>(total) / processes.size();
     }
@@ -5,42 +5,28 @@
 #include <vector>
 #include <algorithm>
 #include <iomanip>
+#include <cstdint>
 
-struct Process {
-    int pid;
-    int arrival_time;
-    int burst_time;
-    int remaining_time;
-    int completion_time;
-    int turnaround_time;
-    int waiting_time;
-    int priority;
-    
-    Process(int id, int at, int bt, int pr = 0) 
-        : pid(id), arrival_time(at), burst_time(bt), 
-          remaining_time(bt), priority(pr) {}
-};
+#include "process_table.h"
 
 class MetricsCalculator {
 private:
-    std::vector<Process> processes;
+    const ProcessTable* processes = nullptr; // viewed, not copied
     int total_time;
     int cpu_idle_time;
 
 public:
-    void setProcesses(const std::vector<Process>& procs) {
-        processes = procs;
+    // The table must outlive the calculator
+    void setProcesses(const ProcessTable& procs) {
+        processes = &procs;
         calculateTotalTime();
     }
     
     void calculateTotalTime() {
-        if (processes.empty()) return;
+        if (processes->empty()) return;
         
-        int max_completion = 0;
-        for (const auto& p : processes) {
-            max_completion = std::max(max_completion, p.completion_time);
-        }
-        total_time = max_completion;
+        const std::vector<int32_t>& completion = processes->completion_time;
+        total_time = *std::max_element(completion.begin(), completion.end());
     }
     
     double getCPUUtilization() {
@@ -49,23 +35,23 @@ public:
     }
     
     double getThroughput() {
-        return static_cast<double>(processes.size()) / total_time;
+        return static_cast<double>(processes->size()) / total_time;
     }
     
     double getAverageWaitingTime() {
         int total_waiting = 0;
-        for (const auto& p : processes) {
-            total_waiting += p.waiting_time;
+        for (size_t i = 0; i < processes->size(); i++) {
+            total_waiting += processes->waitingTime(i);
         }
-        return static_cast<double>(total_waiting) / processes.size();
+        return static_cast<double>(total_waiting) / processes->size();
     }
     
     double getAverageTurnaroundTime() {
         int total_turnaround = 0;
-        for (const auto& p : processes) {
-            total_turnaround += p.turnaround_time;
+        for (size_t i = 0; i < processes->size(); i++) {
+            total_turnaround += processes->turnaroundTime(i);
         }
-        return static_cast<double>(total_turnaround) / processes.size();
+        return static_cast<double>(total_turnaround) / processes->size();
     }
     
     double getAverageResponseTime() {
@@ -88,22 +74,15 @@ public:
 
 // Demo usage
 int main() {
-    std::vector<Process> sample_processes = {
-        Process(1, 0, 7), Process(2, 2, 4), Process(3, 4, 1)
-    };
-    
-    // Simulate some completion times
-    sample_processes[0].completion_time = 7;
-    sample_processes[0].turnaround_time = 7;
-    sample_processes[0].waiting_time = 0;
-    
-    sample_processes[1].completion_time = 11;
-    sample_processes[1].turnaround_time = 9;
-    sample_processes[1].waiting_time = 5;
+    ProcessTable sample_processes;
+    sample_processes.add(1, 0, 7);
+    sample_processes.add(2, 2, 4);
+    sample_processes.add(3, 4, 1);
     
-    sample_processes[2].completion_time = 12;
-    sample_processes[2].turnaround_time = 8;
-    sample_processes[2].waiting_time = 7;
+    // Simulate some completion times (turnaround 7, 9, 8; waiting 0, 5, 7)
+    sample_processes.completion_time[0] = 7;
+    sample_processes.completion_time[1] = 11;
+    sample_processes.completion_time[2] = 12;
     
     MetricsCalculator calc;
     calc.setProcesses(sample_processes);
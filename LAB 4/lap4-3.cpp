@@ -7,27 +7,25 @@
 #include <algorithm>
 #include <climits>
 #include <iomanip>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <linux/perf_event.h>
 
-struct Process {
-    int pid;
-    int arrival_time;
-    int burst_time;
-    int remaining_time;
-    int completion_time;
-    int turnaround_time;
-    int waiting_time;
-    int priority;
-    
-    Process(int id, int at, int bt, int pr = 0) 
-        : pid(id), arrival_time(at), burst_time(bt), 
-          remaining_time(bt), priority(pr), 
-          completion_time(0), turnaround_time(0), waiting_time(0) {}
-};
+#include "process_table.h"
 
 // ProcessScheduler class to handle display and calculations
 class ProcessScheduler {
 public:
-    std::vector<Process> processes;
+    const ProcessTable& processes;
+    
+    explicit ProcessScheduler(const ProcessTable& table) : processes(table) {}
     
     void displayProcesses() {
         std::cout << std::setw(5) << "PID" 
@@ -38,13 +36,13 @@ public:
                   << std::setw(10) << "Waiting" << "\n";
         std::cout << std::string(60, '-') << "\n";
         
-        for (const auto& p : processes) {
-            std::cout << std::setw(5) << p.pid
-                      << std::setw(10) << p.arrival_time
-                      << std::setw(10) << p.burst_time
-                      << std::setw(12) << p.completion_time
-                      << std::setw(12) << p.turnaround_time
-                      << std::setw(10) << p.waiting_time << "\n";
+        for (size_t i = 0; i < processes.size(); i++) {
+            std::cout << std::setw(5) << processes.pid[i]
+                      << std::setw(10) << processes.arrival_time[i]
+                      << std::setw(10) << processes.burst_time[i]
+                      << std::setw(12) << processes.completion_time[i]
+                      << std::setw(12) << processes.turnaroundTime(i)
+                      << std::setw(10) << processes.waitingTime(i) << "\n";
         }
     }
     
@@ -52,8 +50,8 @@ public:
         if (processes.empty()) return 0.0;
         
         double total = 0;
-        for (const auto& p : processes) {
-            total += p.waiting_time;
+        for (size_t i = 0; i < processes.size(); i++) {
+            total += processes.waitingTime(i);
         }
         return total / processes.size();
     }
@@ -62,36 +60,206 @@ public:
         if (processes.empty()) return 0.0;
         
         double total = 0;
-        for (const auto& p : processes) {
-            total += p.turnaround_time;
+        for (size_t i = 0; i < processes.size(); i++) {
+            total += processes.turnaroundTime(i);
         }
         return total / processes.size();
     }
 };
 
+// One contiguous run of a process on a CPU: [start, end)
+struct TimelineSlice {
+    int32_t pid;
+    int32_t start;
+    int32_t end;
+    int32_t cpu;
+};
+
+// Records which process ran when. Adjacent slices of the same process on the
+// same CPU are merged (run-length encoding), so SRTF's 1-unit steps collapse
+// into one slice per contiguous run, even when other CPUs' slices are
+// recorded in between.
+class TimelineRecorder {
+private:
+    std::vector<TimelineSlice> slices; // preallocated; only [0, count) is valid
+    size_t count = 0;
+    int last_cpu = -1;                 // CPU of the newest slice, -1 when empty
+    std::vector<size_t> last_slice;    // per CPU: index + 1 of its latest slice when that
+                                       // is not the newest slice overall, 0 if none
+    
+    void grow() {
+        slices.resize(slices.empty() ? 1024 : slices.size() * 2);
+    }
+    
+    // Another CPU (or none) recorded last: remember where that CPU's run
+    // ended, then merge into this CPU's own latest slice or append a new one
+    __attribute__((noinline)) void recordOnOtherCpu(int pid, int start, int end, int cpu) {
+        size_t c = static_cast<size_t>(cpu);
+        if (c >= last_slice.size()) last_slice.resize(c + 1, 0);
+        if (count > 0) {
+            size_t prev = static_cast<size_t>(last_cpu);
+            if (prev >= last_slice.size()) last_slice.resize(prev + 1, 0);
+            last_slice[prev] = count;
+        }
+        if (last_slice[c] > 0) {
+            TimelineSlice& last = slices[last_slice[c] - 1];
+            if (last.end == start && last.pid == pid) {
+                last.end = end;
+                return;
+            }
+        }
+        if (count == slices.size()) grow();
+        slices[count++] = {pid, start, end, cpu};
+        last_cpu = cpu;
+    }
+    
+    void rebuildLastSlices() {
+        last_slice.clear();
+        for (size_t i = 0; i < count; i++) {
+            size_t cpu = static_cast<size_t>(slices[i].cpu);
+            if (cpu >= last_slice.size()) last_slice.resize(cpu + 1, 0);
+            last_slice[cpu] = i + 1;
+        }
+        last_cpu = count > 0 ? slices[count - 1].cpu : -1;
+    }
+    
+public:
+    static constexpr uint32_t BINARY_MAGIC = 0x544E4147; // "GANT"
+    static constexpr uint32_t BINARY_VERSION = 1;
+    
+    explicit TimelineRecorder(size_t capacity = 1024) : slices(capacity) {}
+    
+    // Same CPU as the newest slice: one merge check, then an append
+    void record(int pid, int start, int end, int cpu = 0) {
+        if (cpu != last_cpu) {
+            recordOnOtherCpu(pid, start, end, cpu);
+            return;
+        }
+        TimelineSlice& last = slices[count - 1];
+        if (last.end == start && last.pid == pid) {
+            last.end = end;
+            return;
+        }
+        if (count == slices.size()) grow();
+        slices[count++] = {pid, start, end, cpu};
+    }
+    
+    void clear() {
+        count = 0;
+        last_cpu = -1;
+        last_slice.clear();
+    }
+    size_t size() const { return count; }
+    const TimelineSlice* begin() const { return slices.data(); }
+    const TimelineSlice* end() const { return slices.data() + count; }
+    
+    bool operator==(const TimelineRecorder& other) const {
+        if (count != other.count) return false;
+        for (size_t i = 0; i < count; i++) {
+            const TimelineSlice& a = slices[i];
+            const TimelineSlice& b = other.slices[i];
+            if (a.pid != b.pid || a.start != b.start || a.end != b.end || a.cpu != b.cpu) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    void displayGantt() const {
+        std::cout << "Gantt: ";
+        for (const auto& s : *this) {
+            std::cout << "[" << s.start << " P" << s.pid << " " << s.end << "]";
+        }
+        std::cout << "\n";
+    }
+    
+    // One Gantt line per CPU, for multicore runs
+    void displayGantt(int num_cpus) const {
+        for (int cpu = 0; cpu < num_cpus; cpu++) {
+            std::cout << "CPU " << cpu << " Gantt: ";
+            for (const auto& s : *this) {
+                if (s.cpu == cpu) std::cout << "[" << s.start << " P" << s.pid << " " << s.end << "]";
+            }
+            std::cout << "\n";
+        }
+    }
+    
+    // Chrome trace-event JSON (load in chrome://tracing or Perfetto).
+    // One time unit is exported as one microsecond.
+    void exportChromeTrace(std::ostream& out) const {
+        out << "{\"traceEvents\":[";
+        for (size_t i = 0; i < count; i++) {
+            const TimelineSlice& s = slices[i];
+            if (i > 0) out << ",";
+            out << "\n{\"name\":\"P" << s.pid << "\",\"ph\":\"X\",\"pid\":0"
+                << ",\"tid\":" << s.cpu
+                << ",\"ts\":" << s.start
+                << ",\"dur\":" << (s.end - s.start)
+                << ",\"args\":{\"pid\":" << s.pid << "}}";
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+    
+    // Binary layout: magic, version, count (uint32 each), then count slices
+    // of four int32 fields in host byte order.
+    void exportBinary(std::ostream& out) const {
+        uint32_t header[3] = {BINARY_MAGIC, BINARY_VERSION, static_cast<uint32_t>(count)};
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(slices.data()),
+                  static_cast<std::streamsize>(count * sizeof(TimelineSlice)));
+    }
+    
+    bool importBinary(std::istream& in) {
+        uint32_t header[3];
+        if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) return false;
+        if (header[0] != BINARY_MAGIC || header[1] != BINARY_VERSION) return false;
+        
+        count = header[2];
+        if (slices.size() < count) slices.resize(count);
+        bool ok = static_cast<bool>(in.read(reinterpret_cast<char*>(slices.data()),
+                                            static_cast<std::streamsize>(count * sizeof(TimelineSlice))));
+        if (!ok) count = 0;
+        rebuildLastSlices();
+        return ok;
+    }
+};
+
+// Each algorithm reads the table's input columns and writes completion_time
+// (and, for the preemptive ones, remaining_time) in place. Call
+// resetResults() before scheduling the same table again.
 class SchedulingAlgorithms {
 public:
     // FCFS Scheduling
-    static void FCFS(std::vector<Process>& processes) {
-        std::sort(processes.begin(), processes.end(), 
-                  [](const Process& a, const Process& b) {
-                      return a.arrival_time < b.arrival_time;
-                  });
+    static void FCFS(ProcessTable& processes, TimelineRecorder* timeline = nullptr) {
+        int n = processes.size();
+        const int32_t* arrival = processes.arrival_time.data();
+        
+        // Visit in arrival order; traces are usually sorted already
+        std::vector<int> order;
+        bool sorted = std::is_sorted(processes.arrival_time.begin(), processes.arrival_time.end());
+        if (!sorted) {
+            order.resize(n);
+            for (int i = 0; i < n; i++) {
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(),
+                             [arrival](int a, int b) { return arrival[a] < arrival[b]; });
+        }
         
         int current_time = 0;
-        for (auto& p : processes) {
-            if (current_time < p.arrival_time) {
-                current_time = p.arrival_time;
+        for (int k = 0; k < n; k++) {
+            int i = sorted ? k : order[k];
+            if (current_time < arrival[i]) {
+                current_time = arrival[i];
             }
-            p.completion_time = current_time + p.burst_time;
-            p.turnaround_time = p.completion_time - p.arrival_time;
-            p.waiting_time = p.turnaround_time - p.burst_time;
-            current_time = p.completion_time;
+            processes.completion_time[i] = current_time + processes.burst_time[i];
+            if (timeline) timeline->record(processes.pid[i], current_time, processes.completion_time[i]);
+            current_time = processes.completion_time[i];
         }
     }
     
     // SJF Non-preemptive Scheduling
-    static void SJF(std::vector<Process>& processes) {
+    static void SJF(ProcessTable& processes, TimelineRecorder* timeline = nullptr) {
         int n = processes.size();
         std::vector<bool> completed(n, false);
         int current_time = 0;
@@ -102,9 +270,9 @@ public:
             int min_burst = INT_MAX;
             
             for (int i = 0; i < n; i++) {
-                if (!completed[i] && processes[i].arrival_time <= current_time) {
-                    if (processes[i].burst_time < min_burst) {
-                        min_burst = processes[i].burst_time;
+                if (!completed[i] && processes.arrival_time[i] <= current_time) {
+                    if (processes.burst_time[i] < min_burst) {
+                        min_burst = processes.burst_time[i];
                         shortest_job = i;
                     }
                 }
@@ -115,24 +283,19 @@ public:
                 continue;
             }
             
-            processes[shortest_job].completion_time = current_time + processes[shortest_job].burst_time;
-            processes[shortest_job].turnaround_time = processes[shortest_job].completion_time - processes[shortest_job].arrival_time;
-            processes[shortest_job].waiting_time = processes[shortest_job].turnaround_time - processes[shortest_job].burst_time;
+            processes.completion_time[shortest_job] = current_time + processes.burst_time[shortest_job];
+            if (timeline) timeline->record(processes.pid[shortest_job], current_time, processes.completion_time[shortest_job]);
             
-            current_time = processes[shortest_job].completion_time;
+            current_time = processes.completion_time[shortest_job];
             completed[shortest_job] = true;
             completed_count++;
         }
     }
     
     // SRTF (Preemptive SJF) Scheduling
-    static void SRTF(std::vector<Process>& processes) {
+    static void SRTF(ProcessTable& processes, TimelineRecorder* timeline = nullptr) {
         int n = processes.size();
-        std::vector<int> remaining_time(n);
-        
-        for (int i = 0; i < n; i++) {
-            remaining_time[i] = processes[i].burst_time;
-        }
+        std::vector<int32_t>& remaining_time = processes.remaining_time;
         
         int current_time = 0;
         int completed = 0;
@@ -142,7 +305,7 @@ public:
             int min_remaining = INT_MAX;
             
             for (int i = 0; i < n; i++) {
-                if (processes[i].arrival_time <= current_time && 
+                if (processes.arrival_time[i] <= current_time && 
                     remaining_time[i] < min_remaining && remaining_time[i] > 0) {
                     min_remaining = remaining_time[i];
                     shortest = i;
@@ -154,28 +317,24 @@ public:
                 continue;
             }
             
+            if (timeline) timeline->record(processes.pid[shortest], current_time, current_time + 1);
             remaining_time[shortest]--;
             current_time++;
             
             if (remaining_time[shortest] == 0) {
                 completed++;
-                processes[shortest].completion_time = current_time;
-                processes[shortest].turnaround_time = processes[shortest].completion_time - processes[shortest].arrival_time;
-                processes[shortest].waiting_time = processes[shortest].turnaround_time - processes[shortest].burst_time;
+                processes.completion_time[shortest] = current_time;
             }
         }
     }
     
     // Round Robin Scheduling
-    static void RoundRobin(std::vector<Process>& processes, int quantum) {
+    static void RoundRobin(ProcessTable& processes, int quantum, TimelineRecorder* timeline = nullptr) {
         std::queue<int> ready_queue;
-        std::vector<int> remaining_time(processes.size());
+        std::vector<int32_t>& remaining_time = processes.remaining_time;
+        const std::vector<int32_t>& arrival_time = processes.arrival_time;
         std::vector<bool> in_queue(processes.size(), false);
         
-        for (size_t i = 0; i < processes.size(); i++) {
-            remaining_time[i] = processes[i].burst_time;
-        }
-        
         int current_time = 0;
         int completed = 0;
         
@@ -185,12 +344,12 @@ public:
             arrival_order[i] = i;
         }
         std::sort(arrival_order.begin(), arrival_order.end(),
-                  [&processes](int a, int b) {
-                      return processes[a].arrival_time < processes[b].arrival_time;
+                  [&arrival_time](int a, int b) {
+                      return arrival_time[a] < arrival_time[b];
                   });
         
         // Add first process if available
-        if (!processes.empty() && processes[arrival_order[0]].arrival_time <= current_time) {
+        if (!processes.empty() && arrival_time[arrival_order[0]] <= current_time) {
             ready_queue.push(arrival_order[0]);
             in_queue[arrival_order[0]] = true;
         }
@@ -199,8 +358,8 @@ public:
             if (ready_queue.empty()) {
                 // Find next arriving process
                 for (int idx : arrival_order) {
-                    if (remaining_time[idx] > 0 && processes[idx].arrival_time > current_time) {
-                        current_time = processes[idx].arrival_time;
+                    if (remaining_time[idx] > 0 && arrival_time[idx] > current_time) {
+                        current_time = arrival_time[idx];
                         ready_queue.push(idx);
                         in_queue[idx] = true;
                         break;
@@ -215,12 +374,13 @@ public:
             
             int exec_time = std::min(quantum, remaining_time[current_process]);
             remaining_time[current_process] -= exec_time;
+            if (timeline) timeline->record(processes.pid[current_process], current_time, current_time + exec_time);
             current_time += exec_time;
             
             // Add newly arrived processes
             for (int idx : arrival_order) {
                 if (!in_queue[idx] && remaining_time[idx] > 0 && 
-                    processes[idx].arrival_time <= current_time && idx != current_process) {
+                    arrival_time[idx] <= current_time && idx != current_process) {
                     ready_queue.push(idx);
                     in_queue[idx] = true;
                 }
@@ -228,11 +388,7 @@ public:
             
             if (remaining_time[current_process] == 0) {
                 completed++;
-                processes[current_process].completion_time = current_time;
-                processes[current_process].turnaround_time = 
-                    processes[current_process].completion_time - processes[current_process].arrival_time;
-                processes[current_process].waiting_time = 
-                    processes[current_process].turnaround_time - processes[current_process].burst_time;
+                processes.completion_time[current_process] = current_time;
             } else {
                 ready_queue.push(current_process);
                 in_queue[current_process] = true;
@@ -241,7 +397,7 @@ public:
     }
     
     // Priority Scheduling (Non-preemptive)
-    static void PriorityScheduling(std::vector<Process>& processes) {
+    static void PriorityScheduling(ProcessTable& processes, TimelineRecorder* timeline = nullptr) {
         int n = processes.size();
         std::vector<bool> completed(n, false);
         int current_time = 0;
@@ -252,9 +408,9 @@ public:
             int highest_priority = INT_MAX; // Lower number = higher priority
             
             for (int i = 0; i < n; i++) {
-                if (!completed[i] && processes[i].arrival_time <= current_time) {
-                    if (processes[i].priority < highest_priority) {
-                        highest_priority = processes[i].priority;
+                if (!completed[i] && processes.arrival_time[i] <= current_time) {
+                    if (processes.priority[i] < highest_priority) {
+                        highest_priority = processes.priority[i];
                         highest_priority_job = i;
                     }
                 }
@@ -265,69 +421,616 @@ public:
                 continue;
             }
             
-            processes[highest_priority_job].completion_time = current_time + processes[highest_priority_job].burst_time;
-            processes[highest_priority_job].turnaround_time = 
-                processes[highest_priority_job].completion_time - processes[highest_priority_job].arrival_time;
-            processes[highest_priority_job].waiting_time = 
-                processes[highest_priority_job].turnaround_time - processes[highest_priority_job].burst_time;
+            processes.completion_time[highest_priority_job] = 
+                current_time + processes.burst_time[highest_priority_job];
+            if (timeline) {
+                timeline->record(processes.pid[highest_priority_job], current_time,
+                                 processes.completion_time[highest_priority_job]);
+            }
             
-            current_time = processes[highest_priority_job].completion_time;
+            current_time = processes.completion_time[highest_priority_job];
             completed[highest_priority_job] = true;
             completed_count++;
         }
     }
 };
 
+// M-processor variants of the algorithms above, as a discrete-event
+// simulation over the same ProcessTable. With a global queue any idle CPU
+// takes the best ready process; with per-CPU queues each arrival goes to
+// the shortest queue and an idle CPU with an empty queue steals from the
+// longest one. A process that runs on a different CPU than the one it last
+// ran on (or was queued on) pays migration_cost time units first.
+class MulticoreScheduler {
+public:
+    enum QueueMode { GLOBAL_QUEUE, PER_CPU_QUEUES };
+    
+private:
+    enum Policy { FCFS_POLICY, SJF_POLICY, SRTF_POLICY, RR_POLICY, PRIORITY_POLICY };
+    
+    struct ReadyEntry {
+        long long key;
+        int process;
+        
+        bool operator>(const ReadyEntry& other) const {
+            return key != other.key ? key > other.key : process > other.process;
+        }
+    };
+    using ReadyQueue = std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, std::greater<ReadyEntry>>;
+    
+    struct CoreEvent {
+        int time;
+        int core;
+        uint64_t version; // stale once the core was preempted
+        
+        bool operator>(const CoreEvent& other) const {
+            return time != other.time ? time > other.time : core > other.core;
+        }
+    };
+    
+    struct Core {
+        int process = -1;      // running process, -1 = idle
+        int slice_start = 0;   // after any migration delay
+        int slice_end = 0;
+        uint64_t version = 0;
+        long long busy_time = 0;
+        long long migration_time = 0;
+    };
+    
+    int num_cores;
+    QueueMode mode;
+    int migration_cost;
+    
+    std::vector<Core> cores;
+    std::vector<ReadyQueue> queues; // one (global) or one per core
+    std::vector<int> last_core;     // per process, -1 = never ran or queued
+    long long migrations = 0;
+    int makespan = 0;
+    int placement_cursor = 0;
+    
+    // Ready-queue order per policy; ties go to the lower process index
+    static long long readyKey(Policy policy, const ProcessTable& processes, int i, long long seq) {
+        switch (policy) {
+            case FCFS_POLICY: return processes.arrival_time[i];
+            case SJF_POLICY: return processes.burst_time[i];
+            case SRTF_POLICY: return processes.remaining_time[i];
+            case PRIORITY_POLICY: return processes.priority[i];
+            default: return seq; // Round Robin: FIFO
+        }
+    }
+    
+    // Ties rotate through the CPUs so equal queues share arrivals evenly
+    int shortestQueue() {
+        int best = 0;
+        size_t best_load = SIZE_MAX;
+        placement_cursor = (placement_cursor + 1) % num_cores;
+        for (int k = 0; k < num_cores; k++) {
+            int c = (placement_cursor + k) % num_cores;
+            size_t load = queues[c].size() + (cores[c].process >= 0 ? 1 : 0);
+            if (load < best_load) {
+                best_load = load;
+                best = c;
+            }
+        }
+        return best;
+    }
+    
+    int longestQueue() const {
+        int best = -1;
+        size_t best_size = 0;
+        for (int c = 0; c < num_cores; c++) {
+            if (queues[c].size() > best_size) {
+                best_size = queues[c].size();
+                best = c;
+            }
+        }
+        return best;
+    }
+    
+    // Ends the running slice at time now and accounts for it
+    void endSlice(ProcessTable& processes, int c, int now, TimelineRecorder* timeline) {
+        Core& core = cores[c];
+        int p = core.process;
+        int ran = std::max(0, now - core.slice_start);
+        processes.remaining_time[p] -= ran;
+        core.busy_time += ran;
+        if (timeline && ran > 0) timeline->record(processes.pid[p], core.slice_start, now, c);
+        last_core[p] = c;
+        core.process = -1;
+        core.version++;
+    }
+    
+    void dispatch(ProcessTable& processes, int c, int p, int now, int quantum,
+                  std::priority_queue<CoreEvent, std::vector<CoreEvent>, std::greater<CoreEvent>>& events) {
+        Core& core = cores[c];
+        int start = now;
+        if (last_core[p] >= 0 && last_core[p] != c) {
+            migrations++;
+            core.migration_time += migration_cost;
+            start += migration_cost;
+        }
+        int run = processes.remaining_time[p];
+        if (quantum > 0) run = std::min(run, quantum);
+        
+        core.process = p;
+        core.slice_start = start;
+        core.slice_end = start + run;
+        events.push({core.slice_end, c, core.version});
+    }
+    
+    void run(ProcessTable& processes, Policy policy, int quantum, TimelineRecorder* timeline) {
+        int n = processes.size();
+        cores.assign(num_cores, Core());
+        queues.assign(mode == GLOBAL_QUEUE ? 1 : num_cores, ReadyQueue());
+        last_core.assign(n, -1);
+        migrations = 0;
+        makespan = 0;
+        placement_cursor = 0;
+        
+        // Arrival order, stable for equal arrival times
+        std::vector<int> arrivals(n);
+        for (int i = 0; i < n; i++) {
+            arrivals[i] = i;
+        }
+        if (!std::is_sorted(processes.arrival_time.begin(), processes.arrival_time.end())) {
+            const int32_t* arrival = processes.arrival_time.data();
+            std::stable_sort(arrivals.begin(), arrivals.end(),
+                             [arrival](int a, int b) { return arrival[a] < arrival[b]; });
+        }
+        
+        std::priority_queue<CoreEvent, std::vector<CoreEvent>, std::greater<CoreEvent>> events;
+        std::vector<int> idle_cores;
+        for (int c = num_cores - 1; c >= 0; c--) {
+            idle_cores.push_back(c);
+        }
+        long long seq = 0;
+        std::vector<int> still_idle;
+        size_t queued = 0;
+        int next_arrival = 0;
+        int completed = 0;
+        
+        auto enqueue = [&](int p, int queue_index) {
+            queues[queue_index].push({readyKey(policy, processes, p, seq++), p});
+            queued++;
+        };
+        
+        while (completed < n) {
+            int now = INT_MAX;
+            if (next_arrival < n) now = processes.arrival_time[arrivals[next_arrival]];
+            while (!events.empty() && events.top().version != cores[events.top().core].version) {
+                events.pop();
+            }
+            if (!events.empty()) now = std::min(now, events.top().time);
+            
+            // Arrivals first, so a process whose quantum expires now queues
+            // behind them, as in the single-CPU Round Robin
+            while (next_arrival < n && processes.arrival_time[arrivals[next_arrival]] == now) {
+                int p = arrivals[next_arrival++];
+                int q = 0;
+                if (mode == PER_CPU_QUEUES) {
+                    q = shortestQueue();
+                    last_core[p] = q; // queued on q's cache
+                }
+                enqueue(p, q);
+                
+                if (policy != SRTF_POLICY) continue;
+                if (mode == GLOBAL_QUEUE && !idle_cores.empty()) continue;
+                
+                // Preempt the running process with the most work left on
+                // the target CPU(s) if the newcomer has less
+                int victim = -1;
+                int victim_remaining = processes.remaining_time[p];
+                for (int c = (mode == PER_CPU_QUEUES ? q : 0); c < (mode == PER_CPU_QUEUES ? q + 1 : num_cores); c++) {
+                    const Core& core = cores[c];
+                    if (core.process < 0) continue;
+                    int left = core.slice_end - std::max(now, core.slice_start);
+                    if (left > victim_remaining) {
+                        victim_remaining = left;
+                        victim = c;
+                    }
+                }
+                if (victim >= 0) {
+                    int preempted = cores[victim].process;
+                    endSlice(processes, victim, now, timeline);
+                    enqueue(preempted, mode == PER_CPU_QUEUES ? victim : 0);
+                    idle_cores.push_back(victim);
+                }
+            }
+            
+            // Slices ending now: completion or expired quantum
+            while (!events.empty() && events.top().time == now) {
+                CoreEvent event = events.top();
+                events.pop();
+                if (event.version != cores[event.core].version) continue;
+                
+                int p = cores[event.core].process;
+                endSlice(processes, event.core, now, timeline);
+                if (processes.remaining_time[p] == 0) {
+                    processes.completion_time[p] = now;
+                    makespan = std::max(makespan, now);
+                    completed++;
+                } else {
+                    enqueue(p, mode == PER_CPU_QUEUES ? event.core : 0);
+                }
+                idle_cores.push_back(event.core);
+            }
+            
+            // Hand ready processes to idle CPUs. With per-CPU queues every
+            // CPU serves its own queue before any CPU steals.
+            for (int pass = 0; pass < 2; pass++) {
+                still_idle.clear();
+                for (int c : idle_cores) {
+                    int q = 0;
+                    if (mode == PER_CPU_QUEUES) {
+                        q = (pass == 0 || queued == 0) ? c : longestQueue();
+                    }
+                    if (queues[q].empty()) {
+                        still_idle.push_back(c);
+                        continue;
+                    }
+                    int p = queues[q].top().process;
+                    queues[q].pop();
+                    queued--;
+                    dispatch(processes, c, p, now, policy == RR_POLICY ? quantum : 0, events);
+                }
+                idle_cores.swap(still_idle);
+                if (mode == GLOBAL_QUEUE) break;
+            }
+        }
+    }
+    
+public:
+    MulticoreScheduler(int cores_count, QueueMode queue_mode, int migration_cost_units = 1)
+        : num_cores(cores_count), mode(queue_mode), migration_cost(migration_cost_units) {}
+    
+    void FCFS(ProcessTable& processes, TimelineRecorder* timeline = nullptr) {
+        run(processes, FCFS_POLICY, 0, timeline);
+    }
+    
+    void SJF(ProcessTable& processes, TimelineRecorder* timeline = nullptr) {
+        run(processes, SJF_POLICY, 0, timeline);
+    }
+    
+    void SRTF(ProcessTable& processes, TimelineRecorder* timeline = nullptr) {
+        run(processes, SRTF_POLICY, 0, timeline);
+    }
+    
+    void RoundRobin(ProcessTable& processes, int quantum, TimelineRecorder* timeline = nullptr) {
+        run(processes, RR_POLICY, quantum, timeline);
+    }
+    
+    void PriorityScheduling(ProcessTable& processes, TimelineRecorder* timeline = nullptr) {
+        run(processes, PRIORITY_POLICY, 0, timeline);
+    }
+    
+    int getMakespan() const { return makespan; }
+    long long getMigrations() const { return migrations; }
+    
+    double getUtilization(int core) const {
+        return makespan > 0 ? 100.0 * cores[core].busy_time / makespan : 0.0;
+    }
+    
+    // Per-core utilization; summarised as min/avg/max for many cores
+    void displayCoreStats() const {
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "CPUs: " << num_cores 
+                  << (mode == GLOBAL_QUEUE ? " (global queue)" : " (per-CPU queues)")
+                  << ", Makespan: " << makespan << ", Migrations: " << migrations << "\n";
+        
+        if (num_cores <= 8) {
+            for (int c = 0; c < num_cores; c++) {
+                std::cout << "CPU " << c << ": Utilization " << getUtilization(c) << "%, Migration overhead "
+                          << cores[c].migration_time << "\n";
+            }
+        } else {
+            double min_util = 100.0, max_util = 0.0, total_util = 0.0;
+            long long total_migration = 0;
+            for (int c = 0; c < num_cores; c++) {
+                double util = getUtilization(c);
+                min_util = std::min(min_util, util);
+                max_util = std::max(max_util, util);
+                total_util += util;
+                total_migration += cores[c].migration_time;
+            }
+            std::cout << "Utilization: min " << min_util << "%, avg " << total_util / num_cores
+                      << "%, max " << max_util << "%, Migration overhead " << total_migration << "\n";
+        }
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+};
+
+// Synthetic trace: arrivals 0-3 units apart, bursts 1-max_burst, priorities 0-4
+ProcessTable makeTrace(int num_jobs, unsigned int seed = 12345, int max_burst = 10) {
+    ProcessTable trace;
+    trace.reserve(num_jobs);
+    int arrival = 0;
+    for (int i = 0; i < num_jobs; i++) {
+        seed = seed * 1103515245u + 12345u;
+        arrival += (seed >> 16) % 4;
+        trace.add(i + 1, arrival, 1 + (seed >> 8) % max_burst, (seed >> 4) % 5);
+    }
+    return trace;
+}
+
+// Compare FCFS on a large trace with and without timeline recording
+void benchmarkTimelineOverhead(int num_jobs) {
+    ProcessTable trace = makeTrace(num_jobs);
+    
+    TimelineRecorder timeline(num_jobs);
+    double best_plain = 1e30, best_recorded = 1e30;
+    
+    for (int run = 0; run < 5; run++) {
+        trace.resetResults();
+        auto start = std::chrono::steady_clock::now();
+        SchedulingAlgorithms::FCFS(trace);
+        auto end = std::chrono::steady_clock::now();
+        best_plain = std::min(best_plain, std::chrono::duration<double, std::milli>(end - start).count());
+        
+        trace.resetResults();
+        timeline.clear();
+        start = std::chrono::steady_clock::now();
+        SchedulingAlgorithms::FCFS(trace, &timeline);
+        end = std::chrono::steady_clock::now();
+        best_recorded = std::min(best_recorded, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    
+    std::cout << "=== Timeline Recording Overhead (FCFS, " << num_jobs << " jobs) ===\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Without timeline: " << best_plain << " ms\n";
+    std::cout << "With timeline:    " << best_recorded << " ms (" << timeline.size() << " slices)\n";
+    std::cout << "Overhead: " << (best_recorded - best_plain) / best_plain * 100.0 << "%\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+// 128 simulated CPUs on a trace that keeps about 124 of them busy: every
+// algorithm with a global queue and with per-CPU queues
+void benchmarkMulticore(int num_jobs, int num_cores) {
+    ProcessTable trace = makeTrace(num_jobs, 12345, 370);
+    ProcessScheduler metrics(trace);
+    
+    std::cout << "\n=== Multicore Simulation (" << num_jobs << " jobs, " << num_cores << " CPUs) ===\n";
+    const char* names[] = {"FCFS", "SJF", "SRTF", "Round Robin (Quantum=20)", "Priority"};
+    for (int algorithm = 0; algorithm < 5; algorithm++) {
+        for (MulticoreScheduler::QueueMode mode : {MulticoreScheduler::GLOBAL_QUEUE, MulticoreScheduler::PER_CPU_QUEUES}) {
+            MulticoreScheduler scheduler(num_cores, mode, 2);
+            trace.resetResults();
+            
+            auto start = std::chrono::steady_clock::now();
+            switch (algorithm) {
+                case 0: scheduler.FCFS(trace); break;
+                case 1: scheduler.SJF(trace); break;
+                case 2: scheduler.SRTF(trace); break;
+                case 3: scheduler.RoundRobin(trace, 20); break;
+                default: scheduler.PriorityScheduling(trace); break;
+            }
+            auto end = std::chrono::steady_clock::now();
+            
+            std::cout << "\n--- " << names[algorithm] << " --- simulated in " 
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
+            scheduler.displayCoreStats();
+            std::cout << "Average Waiting Time: " << metrics.calculateAverageWaitingTime() 
+                      << ", Average Turnaround Time: " << metrics.calculateAverageTurnaroundTime() << "\n";
+        }
+    }
+}
+
+// Hardware cache-miss counter for the calling thread (perf_event_open).
+// Unavailable on hosts without a PMU or with perf_event_paranoid > 2.
+class CacheMissCounter {
+private:
+    int fd = -1;
+    int open_error = 0;
+    
+public:
+    CacheMissCounter() {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd < 0) open_error = errno;
+    }
+    
+    ~CacheMissCounter() {
+        if (fd >= 0) close(fd);
+    }
+    
+    bool available() const { return fd >= 0; }
+    const char* error() const { return std::strerror(open_error); }
+    
+    void start() {
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    
+    long long stop() {
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) return -1;
+        return count;
+    }
+};
+
+// Old array-of-structs layout vs ProcessTable on the scan at the heart of
+// SJF/SRTF: count processes that have arrived and still have work left
+void benchmarkProcessTableLayout(int num_jobs) {
+    struct ProcessRow {
+        int pid, arrival_time, burst_time, remaining_time;
+        int completion_time, turnaround_time, waiting_time, priority;
+    };
+    
+    ProcessTable table = makeTrace(num_jobs);
+    std::vector<ProcessRow> rows(num_jobs);
+    for (int i = 0; i < num_jobs; i++) {
+        rows[i] = {table.pid[i], table.arrival_time[i], table.burst_time[i], table.remaining_time[i],
+                   0, 0, 0, table.priority[i]};
+    }
+    int now = table.arrival_time[num_jobs / 2];
+    
+    CacheMissCounter counter;
+    double best_rows = 1e30, best_table = 1e30;
+    long long misses_rows = -1, misses_table = -1;
+    long long ready_rows = 0, ready_table = 0;
+    
+    for (int run = 0; run < 5; run++) {
+        counter.start();
+        auto start = std::chrono::steady_clock::now();
+        ready_rows = 0;
+        for (const auto& p : rows) {
+            ready_rows += (p.arrival_time <= now && p.remaining_time > 0);
+        }
+        auto end = std::chrono::steady_clock::now();
+        long long misses = counter.stop();
+        if (misses_rows < 0 || misses < misses_rows) misses_rows = misses;
+        best_rows = std::min(best_rows, std::chrono::duration<double, std::milli>(end - start).count());
+        
+        counter.start();
+        start = std::chrono::steady_clock::now();
+        ready_table = 0;
+        const int32_t* arrival = table.arrival_time.data();
+        const int32_t* remaining = table.remaining_time.data();
+        for (int i = 0; i < num_jobs; i++) {
+            ready_table += (arrival[i] <= now && remaining[i] > 0);
+        }
+        end = std::chrono::steady_clock::now();
+        misses = counter.stop();
+        if (misses_table < 0 || misses < misses_table) misses_table = misses;
+        best_table = std::min(best_table, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    
+    const double MB = 1024.0 * 1024.0;
+    const long long CACHE_LINE = 64;
+    std::cout << "\n=== Process Table Layout (" << num_jobs << " processes) ===\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Array of structs: " << rows.size() * sizeof(ProcessRow) / MB 
+              << " MB, plus a full copy per algorithm run\n";
+    std::cout << "Process table:    " << table.bytes() / MB << " MB, results reset in place\n";
+    std::cout << "Ready scan, array of structs: " << best_rows << " ms, "
+              << rows.size() * sizeof(ProcessRow) / CACHE_LINE << " cache lines";
+    if (counter.available()) std::cout << ", " << misses_rows << " cache misses";
+    std::cout << " (" << ready_rows << " ready)\n";
+    std::cout << "Ready scan, process table:    " << best_table << " ms, "
+              << num_jobs * 2 * sizeof(int32_t) / CACHE_LINE << " cache lines";
+    if (counter.available()) std::cout << ", " << misses_table << " cache misses";
+    std::cout << " (" << ready_table << " ready)\n";
+    if (!counter.available()) {
+        std::cout << "Hardware cache-miss counter unavailable: " << counter.error() << "\n";
+    }
+    std::cout.unsetf(std::ios::fixed);
+}
+
 // Demo main function
-int main() {
+int main(int argc, char* argv[]) {
+    // The long benchmarks run on request
+    bool runBenchmarks = argc > 1 && std::string(argv[1]) == "--benchmark";
+    
     // Test data pid, arrival_time, burst_time, priority
-    std::vector<Process> processes = {
-        Process(1, 0, 7, 2),
-        Process(2, 2, 4, 1),
-        Process(3, 4, 1, 4),
-        Process(4, 5, 4, 3)
-    };
+    ProcessTable processes;
+    processes.add(1, 0, 7, 2);
+    processes.add(2, 2, 4, 1);
+    processes.add(3, 4, 1, 4);
+    processes.add(4, 5, 4, 3);
+    
+    TimelineRecorder fcfs_timeline, sjf_timeline, srtf_timeline, rr_timeline, priority_timeline;
+    ProcessScheduler scheduler(processes);
     
     std::cout << "=== FCFS Scheduling ===\n";
-    auto fcfs_processes = processes;
-    SchedulingAlgorithms::FCFS(fcfs_processes);
-    ProcessScheduler scheduler;
-    scheduler.processes = fcfs_processes;
+    processes.resetResults();
+    fcfs_timeline.clear();
+    SchedulingAlgorithms::FCFS(processes, &fcfs_timeline);
     scheduler.displayProcesses();
+    fcfs_timeline.displayGantt();
     std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
     std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
     
     std::cout << "=== SJF Scheduling ===\n";
-    auto sjf_processes = processes;
-    SchedulingAlgorithms::SJF(sjf_processes);
-    scheduler.processes = sjf_processes;
+    processes.resetResults();
+    sjf_timeline.clear();
+    SchedulingAlgorithms::SJF(processes, &sjf_timeline);
     scheduler.displayProcesses();
+    sjf_timeline.displayGantt();
     std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
     std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
     
     std::cout << "=== SRTF Scheduling ===\n";
-    auto srtf_processes = processes;
-    SchedulingAlgorithms::SRTF(srtf_processes);
-    scheduler.processes = srtf_processes;
+    processes.resetResults();
+    srtf_timeline.clear();
+    SchedulingAlgorithms::SRTF(processes, &srtf_timeline);
     scheduler.displayProcesses();
+    srtf_timeline.displayGantt();
     std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
     std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
     
     std::cout << "=== Round Robin (Quantum=2) Scheduling ===\n";
-    auto rr_processes = processes;
-    SchedulingAlgorithms::RoundRobin(rr_processes, 2);
-    scheduler.processes = rr_processes;
+    processes.resetResults();
+    rr_timeline.clear();
+    SchedulingAlgorithms::RoundRobin(processes, 2, &rr_timeline);
     scheduler.displayProcesses();
+    rr_timeline.displayGantt();
     std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
     std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
     
     std::cout << "=== Priority Scheduling ===\n";
-    auto priority_processes = processes;
-    SchedulingAlgorithms::PriorityScheduling(priority_processes);
-    scheduler.processes = priority_processes;
+    processes.resetResults();
+    priority_timeline.clear();
+    SchedulingAlgorithms::PriorityScheduling(processes, &priority_timeline);
     scheduler.displayProcesses();
+    priority_timeline.displayGantt();
     std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
     std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
     
+    std::cout << "=== Multicore Scheduling (2 CPUs, migration cost 1) ===\n";
+    for (MulticoreScheduler::QueueMode mode : {MulticoreScheduler::GLOBAL_QUEUE, MulticoreScheduler::PER_CPU_QUEUES}) {
+        MulticoreScheduler multicore(2, mode, 1);
+        TimelineRecorder multicore_timeline;
+        
+        std::cout << "--- SRTF ---\n";
+        processes.resetResults();
+        multicore.SRTF(processes, &multicore_timeline);
+        scheduler.displayProcesses();
+        multicore_timeline.displayGantt(2);
+        multicore.displayCoreStats();
+        std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
+        std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n";
+        
+        std::cout << "--- Round Robin (Quantum=2) ---\n";
+        multicore_timeline.clear();
+        processes.resetResults();
+        multicore.RoundRobin(processes, 2, &multicore_timeline);
+        scheduler.displayProcesses();
+        multicore_timeline.displayGantt(2);
+        multicore.displayCoreStats();
+        std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
+        std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
+    }
+    
+    // Export the Round Robin schedule for visualisation and diffing
+    std::ofstream json_out("rr_timeline.json");
+    rr_timeline.exportChromeTrace(json_out);
+    std::ofstream bin_out("rr_timeline.bin", std::ios::binary);
+    rr_timeline.exportBinary(bin_out);
+    bin_out.close();
+    
+    TimelineRecorder reloaded;
+    std::ifstream bin_in("rr_timeline.bin", std::ios::binary);
+    bool same = reloaded.importBinary(bin_in) && reloaded == rr_timeline;
+    std::cout << "Round Robin timeline exported to rr_timeline.json / rr_timeline.bin ("
+              << rr_timeline.size() << " slices, reload " << (same ? "matches" : "DIFFERS") << ")\n\n";
+    
+    if (runBenchmarks) {
+        benchmarkTimelineOverhead(1000000);
+        benchmarkProcessTableLayout(10000000);
+        benchmarkMulticore(1000000, 128);
+    } else {
+        std::cout << "Run with --benchmark for the timeline overhead, process table layout and 128-CPU benchmarks (about 10 seconds).\n";
+    }
+    
     return 0;
 }
\ No newline at end of file
@@ -11,6 +11,22 @@
 #include <atomic>
 #include <algorithm>
 #include <functional>
+#include <memory>
+#include <cstdint>
+#include <climits>
+#include <iomanip>
+#include <string>
+#include <system_error>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+#include "sched_sync.h"
 
 class ThreadInfo {
 public:
@@ -26,6 +42,8 @@ public:
         arrival_time = std::chrono::steady_clock::now();
     }
     
+    ThreadInfo() : ThreadInfo(0, 0, 0) {}
+    
     // Copy constructor
     ThreadInfo(const ThreadInfo& other) = default;
     
@@ -33,94 +51,414 @@ public:
     ThreadInfo& operator=(const ThreadInfo& other) = default;
 };
 
-// Custom comparator for priority queue
-struct ThreadComparator {
-    bool operator()(const ThreadInfo& a, const ThreadInfo& b) const {
-        // Higher priority number = higher priority (reverse comparison for max heap)
-        return a.priority < b.priority;
+// Bounded lock-free MPMC FIFO (Vyukov). Each cell carries a sequence number
+// that tells producers and consumers whose turn it is, so neither side locks.
+template <typename T>
+class MPMCQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        std::atomic<long long> enqueued_ns; // readable while another thread pops
+        T data;
+    };
+    
+    std::unique_ptr<Cell[]> buffer;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueue_pos{0};
+    alignas(64) std::atomic<size_t> dequeue_pos{0};
+    
+public:
+    // capacity must be a power of two
+    explicit MPMCQueue(size_t capacity) : buffer(new Cell[capacity]), mask(capacity - 1) {
+        for (size_t i = 0; i < capacity; i++) {
+            buffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    
+    bool tryPush(const T& item, long long now_ns) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = buffer[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = item;
+                    cell.enqueued_ns.store(now_ns, std::memory_order_relaxed);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    bool tryPop(T& item) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = buffer[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    item = cell.data;
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // empty
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    // Enqueue time of the current head; may be stale if another consumer
+    // pops it concurrently, which only matters for aging decisions
+    bool peekHeadTime(long long& enqueued_ns) const {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        const Cell& cell = buffer[pos & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+        enqueued_ns = cell.enqueued_ns.load(std::memory_order_relaxed);
+        return true;
     }
 };
 
-class ThreadScheduler {
+// Priority queue shared by all dispatcher workers: one lock-free FIFO per
+// priority level and a bitmap of levels that may be non-empty.
+//
+// Aging: a waiting thread's effective priority is its level plus one level
+// per aging_step of waiting, so low-priority work eventually outranks a
+// steady stream of high-priority arrivals.
+class ConcurrentPriorityQueue {
+public:
+    static constexpr int NUM_LEVELS = 32;
+    
 private:
-    std::priority_queue<ThreadInfo, std::vector<ThreadInfo>, ThreadComparator> ready_queue;
-    std::mutex queue_mutex;
+    std::vector<std::unique_ptr<MPMCQueue<ThreadInfo>>> levels;
+    std::atomic<uint32_t> nonempty{0};
+    long long aging_step_ns;
+    
+    // A push may land between a failed pop and the bit being cleared, so
+    // look again and restore the bit if the level is not really empty
+    void clearLevel(int level) {
+        nonempty.fetch_and(~(1u << level));
+        long long ignored;
+        if (levels[level]->peekHeadTime(ignored)) {
+            nonempty.fetch_or(1u << level);
+        }
+    }
+    
+public:
+    explicit ConcurrentPriorityQueue(long long aging_step_ns, size_t level_capacity = 4096)
+        : aging_step_ns(aging_step_ns) {
+        for (int i = 0; i < NUM_LEVELS; i++) {
+            levels.push_back(std::make_unique<MPMCQueue<ThreadInfo>>(level_capacity));
+        }
+    }
+    
+    static int levelOf(int priority) {
+        return std::max(0, std::min(NUM_LEVELS - 1, priority));
+    }
+    
+    // Returns false if the thread's level is full
+    bool tryPush(const ThreadInfo& info, long long now_ns) {
+        int level = levelOf(info.priority);
+        if (!levels[level]->tryPush(info, now_ns)) return false;
+        nonempty.fetch_or(1u << level);
+        return true;
+    }
+    
+    // Pops the head with the highest effective priority at time now. aged is
+    // set when that was not the highest non-empty level.
+    bool pop(ThreadInfo& info, bool& aged, long long now) {
+        while (true) {
+            uint32_t bits = nonempty.load();
+            if (bits == 0) return false;
+            
+            int top_level = -1;
+            int best_level = -1;
+            long long best_score = LLONG_MIN;
+            
+            while (bits) {
+                int level = 31 - __builtin_clz(bits);
+                bits &= ~(1u << level);
+                
+                long long enqueued_ns;
+                if (!levels[level]->peekHeadTime(enqueued_ns)) {
+                    clearLevel(level);
+                    continue;
+                }
+                if (top_level < 0) top_level = level;
+                long long score = level * aging_step_ns + (now - enqueued_ns);
+                if (score > best_score) {
+                    best_score = score;
+                    best_level = level;
+                }
+            }
+            
+            if (best_level >= 0 && levels[best_level]->tryPop(info)) {
+                aged = best_level != top_level;
+                return true;
+            }
+        }
+    }
+    
+    bool empty() const {
+        long long ignored;
+        for (const auto& level : levels) {
+            if (level->peekHeadTime(ignored)) return false;
+        }
+        return true;
+    }
+};
+
+// Latch whose count can grow while it is in use: add() per submission,
+// countDown() per completion, wait() returns once everything submitted so
+// far has completed. Only the final countDown touches the mutex.
+class CompletionLatch {
+private:
+    std::atomic<int> pending{0};
+    std::mutex mutex;
     std::condition_variable cv;
+    
+public:
+    void add(int n = 1) {
+        pending.fetch_add(n);
+    }
+    
+    void countDown() {
+        if (pending.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cv.notify_all();
+        }
+    }
+    
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return pending.load() == 0; });
+    }
+};
+
+class ThreadScheduler {
+private:
+    ConcurrentPriorityQueue ready_queue;
+    EventCount work_event;
+    CompletionLatch completion;
+    std::vector<std::thread> workers;
+    std::mutex output_mutex;
     std::atomic<bool> running{true};
     std::atomic<int> submitted_threads{0};
     std::atomic<int> completed_threads{0};
+    std::atomic<int> aged_dispatches{0};
+    bool verbose = true;
+    
+    // Virtual-time mode: dispatchers are actors 0..n-1, the submitting
+    // thread is actor n. Bursts advance the clock instead of sleeping.
+    bool virtual_time = false;
+    std::unique_ptr<VirtualClock> clock;
+    int submitter_actor = -1;
+    bool submitter_finished = false;
+    uint64_t trace_hash = 14695981039346656037ull; // FNV-1a over (id, start)
+    
+    // Per-priority-level dispatch latency (arrival -> start)
+    std::atomic<long long> wait_total_ns[ConcurrentPriorityQueue::NUM_LEVELS] = {};
+    std::atomic<long long> wait_max_ns[ConcurrentPriorityQueue::NUM_LEVELS] = {};
+    std::atomic<int> wait_count[ConcurrentPriorityQueue::NUM_LEVELS] = {};
     
 public:
-    ThreadScheduler() = default;
+    explicit ThreadScheduler(int aging_step_ms = 200)
+        : ready_queue(static_cast<long long>(aging_step_ms) * 1000000) {}
+    
+    ~ThreadScheduler() {
+        stop();
+        join();
+    }
+    
+    void setVerbose(bool enabled) { verbose = enabled; }
+    
+    // Run on a simulated clock instead of sleeping; call before start().
+    // The thread that calls addThread() must then call enterAsSubmitter().
+    void useVirtualTime() { virtual_time = true; }
+    
+    long long nowNs() const {
+        if (virtual_time) return clock->now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>
+            (std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    // Starts num_workers dispatcher threads running scheduler()
+    void start(int num_workers) {
+        if (virtual_time) {
+            clock = std::make_unique<VirtualClock>(num_workers + 1);
+            submitter_actor = num_workers;
+        }
+        for (int i = 0; i < num_workers; i++) {
+            workers.emplace_back(&ThreadScheduler::scheduler, this, i);
+        }
+    }
+    
+    // Virtual time only: joins the simulation as the submitting actor
+    void enterAsSubmitter() {
+        if (virtual_time) clock->start(submitter_actor);
+    }
+    
+    // Delays the submitting thread, on whichever clock is in use
+    void pause(int ms) {
+        if (virtual_time) {
+            clock->sleepFor(submitter_actor, ms * 1000000LL);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        }
+    }
+    
+    void join() {
+        for (auto& worker : workers) {
+            if (worker.joinable()) worker.join();
+        }
+        workers.clear();
+    }
     
     void addThread(const ThreadInfo& thread_info) {
-        {
-            std::lock_guard<std::mutex> lock(queue_mutex);
-            ready_queue.push(thread_info);
-            submitted_threads++;
+        submitted_threads++;
+        completion.add();
+        
+        ThreadInfo queued = thread_info;
+        if (virtual_time) {
+            queued.arrival_time = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(nowNs()));
+        }
+        while (!ready_queue.tryPush(queued, nowNs())) {
+            // Level full - let the dispatchers drain it
+            if (virtual_time) {
+                clock->wakeIdle();
+                clock->sleepFor(submitter_actor, 0);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        
+        if (virtual_time) {
+            clock->wakeIdle();
+        } else {
+            work_event.notifyOne();
         }
-        cv.notify_one();
     }
     
-    void scheduler() {
+    // Dispatcher worker loop; several may run at once
+    void scheduler(int worker_id = 0) {
+        if (virtual_time) clock->start(worker_id);
+        
         while (true) {
-            std::unique_lock<std::mutex> lock(queue_mutex);
+            ThreadInfo current_thread;
+            bool aged = false;
             
-            // Wait until there's a thread to process or we're told to stop
-            cv.wait(lock, [this] { 
-                return !ready_queue.empty() || !running.load(); 
-            });
+            if (ready_queue.pop(current_thread, aged, nowNs())) {
+                execute(worker_id, current_thread, aged);
+                continue;
+            }
             
-            // Check if we should exit
-            if (!running.load() && ready_queue.empty()) {
-                break;
+            if (virtual_time) {
+                if (!running.load()) break;
+                clock->waitIdle(worker_id);
+                continue;
             }
             
+            // Park until there's a thread to process or we're told to stop
+            uint64_t key = work_event.prepareWait();
             if (!ready_queue.empty()) {
-                ThreadInfo current_thread = ready_queue.top();
-                ready_queue.pop();
-                lock.unlock();
-                
-                // Simulate thread execution
-                current_thread.start_time = std::chrono::steady_clock::now();
-                std::cout << "Executing Thread " << current_thread.thread_id 
-                          << " (Priority: " << current_thread.priority << ")\n";
-                
-                std::this_thread::sleep_for(std::chrono::milliseconds(current_thread.burst_time * 100));
-                
-                current_thread.completion_time = std::chrono::steady_clock::now();
-                
-                auto turnaround_time = std::chrono::duration_cast<std::chrono::milliseconds>
-                    (current_thread.completion_time - current_thread.arrival_time);
-                
-                std::cout << "Thread " << current_thread.thread_id 
-                          << " completed. Turnaround time: " << turnaround_time.count() << "ms\n";
-                
-                // Update completed counter
-                completed_threads++;
-                
-                // Notify waiters
-                cv.notify_all();
+                work_event.cancelWait();
+                continue;
+            }
+            if (!running.load()) {
+                work_event.cancelWait();
+                break;
             }
+            work_event.wait(key);
+        }
+        
+        if (virtual_time) clock->finish(worker_id);
+    }
+    
+    void execute(int worker_id, ThreadInfo& current_thread, bool aged) {
+        // Simulate thread execution
+        current_thread.start_time = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(nowNs()));
+        recordWait(current_thread);
+        if (aged) aged_dispatches++;
+        
+        if (verbose) {
+            std::lock_guard<std::mutex> lock(output_mutex);
+            std::cout << "Executing Thread " << current_thread.thread_id 
+                      << " (Priority: " << current_thread.priority << ")"
+                      << (aged ? " [aged]" : "") << "\n";
+        }
+        
+        if (virtual_time) {
+            trace_hash = (trace_hash ^ static_cast<uint64_t>(current_thread.thread_id)) * 1099511628211ull;
+            trace_hash = (trace_hash ^ static_cast<uint64_t>(nowNs())) * 1099511628211ull;
+            clock->sleepFor(worker_id, current_thread.burst_time * 100 * 1000000LL);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(current_thread.burst_time * 100));
+        }
+        
+        current_thread.completion_time = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(nowNs()));
+        
+        if (verbose) {
+            auto turnaround_time = std::chrono::duration_cast<std::chrono::milliseconds>
+                (current_thread.completion_time - current_thread.arrival_time);
+            std::lock_guard<std::mutex> lock(output_mutex);
+            std::cout << "Thread " << current_thread.thread_id 
+                      << " completed. Turnaround time: " << turnaround_time.count() << "ms\n";
+        }
+        
+        // Update completed counter
+        completed_threads++;
+        if (virtual_time) {
+            clock->wakeIdle();
+        } else {
+            completion.countDown();
+        }
+    }
+    
+    void recordWait(const ThreadInfo& info) {
+        int level = ConcurrentPriorityQueue::levelOf(info.priority);
+        long long waited = std::chrono::duration_cast<std::chrono::nanoseconds>
+            (info.start_time - info.arrival_time).count();
+        wait_total_ns[level] += waited;
+        wait_count[level]++;
+        long long prev_max = wait_max_ns[level].load();
+        while (waited > prev_max && !wait_max_ns[level].compare_exchange_weak(prev_max, waited)) {
         }
-        std::cout << "Scheduler stopped. Total threads completed: " << completed_threads.load() << "\n";
     }
     
     void stop() {
         running.store(false);
-        cv.notify_all();
+        if (virtual_time) {
+            if (!clock || submitter_finished) return;
+            clock->wakeIdle();
+            clock->finish(submitter_actor);
+            submitter_finished = true;
+        } else {
+            work_event.notifyAll();
+        }
     }
     
     void waitForCompletion() {
-        // Simple busy wait with short sleeps to avoid deadlock
-        while (completed_threads.load() < submitted_threads.load()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (virtual_time) {
+            while (completed_threads.load() < submitted_threads.load()) {
+                clock->waitIdle(submitter_actor);
+            }
+        } else {
+            completion.wait();
         }
-        
-        // Give a bit more time to ensure all output is flushed
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
     
+    // Order-sensitive hash of (thread id, start time); identical across
+    // virtual-time runs with the same input
+    uint64_t getTraceHash() const { return trace_hash; }
+    
     int getCompletedThreadsCount() const {
         return completed_threads.load();
     }
@@ -128,9 +466,21 @@ public:
     int getSubmittedThreadsCount() const {
         return submitted_threads.load();
     }
+    
+    void displayLatencyByPriority() {
+        std::cout << "Priority  Dispatched  Avg wait (us)  Max wait (us)\n";
+        for (int level = ConcurrentPriorityQueue::NUM_LEVELS - 1; level >= 0; level--) {
+            int count = wait_count[level].load();
+            if (count == 0) continue;
+            std::cout << std::setw(8) << level << std::setw(12) << count
+                      << std::setw(15) << wait_total_ns[level].load() / 1000 / count
+                      << std::setw(15) << wait_max_ns[level].load() / 1000 << "\n";
+        }
+        std::cout << "Dispatched out of priority order by aging: " << aged_dispatches.load() << "\n";
+    }
 };
 
-// Pthread-style thread attributes simulation with custom enum names
+// Pthread-style thread attributes, applied to real OS threads
 class ThreadAttributes {
 public:
     // Use custom names to avoid conflicts with system constants
@@ -139,11 +489,189 @@ public:
     
     SchedulingPolicy policy = POLICY_OTHER;
     ContentionScope scope = SCOPE_SYSTEM;
-    int priority = 0;
+    int priority = 0;               // real-time priority, FIFO/RR only
+    int nice_value = 0;             // SCHED_OTHER weight, -20 (high) .. 19 (low)
+    std::vector<int> cpu_affinity;  // empty = any CPU
     
     void setSchedulingPolicy(SchedulingPolicy pol) { policy = pol; }
     void setContentionScope(ContentionScope sc) { scope = sc; }
     void setPriority(int prio) { priority = prio; }
+    void setNiceValue(int nice) { nice_value = nice; }
+    void setCpuAffinity(const std::vector<int>& cpus) { cpu_affinity = cpus; }
+    
+    // A thread started by launch(). Like std::thread it must be joined
+    // before it is destroyed.
+    class Thread {
+    private:
+        pthread_t handle{};
+        bool started = false;
+        
+    public:
+        Thread() = default;
+        explicit Thread(pthread_t h) : handle(h), started(true) {}
+        Thread(Thread&& other) noexcept : handle(other.handle), started(other.started) {
+            other.started = false;
+        }
+        Thread& operator=(Thread&& other) noexcept {
+            if (started) std::terminate();
+            handle = other.handle;
+            started = other.started;
+            other.started = false;
+            return *this;
+        }
+        ~Thread() {
+            if (started) std::terminate();
+        }
+        
+        bool joinable() const { return started; }
+        void join() {
+            pthread_join(handle, nullptr);
+            started = false;
+        }
+    };
+    
+    int nativePolicy() const {
+        return policy == POLICY_FIFO ? SCHED_FIFO : 
+               policy == POLICY_RR ? SCHED_RR : SCHED_OTHER;
+    }
+    
+    // Real-time priorities are clamped to what the kernel accepts (1-99 on
+    // Linux); SCHED_OTHER only accepts 0
+    int nativePriority() const {
+        int native = nativePolicy();
+        return std::max(sched_get_priority_min(native),
+                        std::min(sched_get_priority_max(native), priority));
+    }
+    
+    // Fills attr with the policy, priority, scope and affinity; the nice
+    // value has no pthread attribute and is applied by the thread itself
+    void fillPthreadAttr(pthread_attr_t& attr) const {
+        sched_param param{};
+        param.sched_priority = nativePriority();
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, nativePolicy());
+        pthread_attr_setschedparam(&attr, &param);
+        pthread_attr_setscope(&attr, scope == SCOPE_PROCESS ? PTHREAD_SCOPE_PROCESS : PTHREAD_SCOPE_SYSTEM);
+        
+        if (!cpu_affinity.empty()) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : cpu_affinity) CPU_SET(cpu, &set);
+            pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+        }
+    }
+    
+private:
+    static void* threadMain(void* arg) {
+        std::unique_ptr<std::function<void()>> start(static_cast<std::function<void()>*>(arg));
+        (*start)();
+        return nullptr;
+    }
+    
+    // Runs on the launched thread. create_error is empty if pthread_create
+    // accepted the attributes, otherwise the thread applies them itself.
+    void runLaunched(const std::string& create_error, const std::function<void()>& body) const {
+        std::string problems;
+        if (create_error.empty()) {
+            problems = applyNiceToCurrentThread();
+        } else {
+            problems = "attributes refused at creation (" + create_error + "); " + applyToCurrentThread();
+        }
+        if (!problems.empty()) {
+            problems.resize(problems.size() - 2); // drop trailing "; "
+            std::cout << "ThreadAttributes fallback: " + problems + "\n";
+        }
+        body();
+    }
+    
+    std::string applyNiceToCurrentThread() const {
+        if (nice_value == 0) return "";
+        
+        // On Linux the nice value of a thread id affects only that thread
+        pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        if (setpriority(PRIO_PROCESS, tid, nice_value) != 0) {
+            return std::string("nice ") + std::to_string(nice_value) + " not applied ("
+                   + std::strerror(errno) + "); ";
+        }
+        return "";
+    }
+    
+public:
+    // Applies the attributes to the calling thread. Anything the kernel
+    // refuses (real-time policies and negative nice need CAP_SYS_NICE or an
+    // RLIMIT_RTPRIO) is left at its default and described in the result;
+    // an empty result means everything was applied.
+    std::string applyToCurrentThread() const {
+        std::string problems;
+        
+        if (scope == SCOPE_PROCESS) {
+            problems += "process contention scope is not supported by Linux, using system scope; ";
+        }
+        
+        sched_param param{};
+        param.sched_priority = nativePriority();
+        int err = pthread_setschedparam(pthread_self(), nativePolicy(), &param);
+        if (err != 0) {
+            problems += std::string("policy not applied (") + std::strerror(err) + "), staying SCHED_OTHER; ";
+        }
+        
+        problems += applyNiceToCurrentThread();
+        
+        if (!cpu_affinity.empty()) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : cpu_affinity) CPU_SET(cpu, &set);
+            err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            if (err != 0) {
+                problems += std::string("affinity not applied (") + std::strerror(err) + "); ";
+            }
+        }
+        
+        return problems;
+    }
+    
+    // Starts body on a new thread created with these attributes. If the
+    // kernel refuses them (EPERM for real-time policies when unprivileged,
+    // EINVAL for CPUs the host does not have), the thread is created with
+    // default attributes and applies what it can itself.
+    Thread launch(std::function<void()> body) const {
+        ThreadAttributes attrs = *this;
+        // Owned, and deleted, by the new thread
+        auto* start = new std::function<void()>([attrs, body] { attrs.runLaunched("", body); });
+        
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        fillPthreadAttr(attr);
+        pthread_t handle;
+        int err = pthread_create(&handle, &attr, &ThreadAttributes::threadMain, start);
+        pthread_attr_destroy(&attr);
+        
+        if (err != 0) {
+            std::string refused = std::strerror(err);
+            *start = [attrs, body, refused] { attrs.runLaunched(refused, body); };
+            err = pthread_create(&handle, nullptr, &ThreadAttributes::threadMain, start);
+        }
+        if (err != 0) {
+            delete start;
+            throw std::system_error(err, std::generic_category(), "pthread_create");
+        }
+        return Thread(handle);
+    }
+    
+    // Effective policy, priority, nice value and CPU of the calling thread
+    static std::string describeCurrentThread() {
+        int native;
+        sched_param param{};
+        pthread_getschedparam(pthread_self(), &native, &param);
+        pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        errno = 0;
+        int nice = getpriority(PRIO_PROCESS, tid);
+        
+        std::string name = native == SCHED_FIFO ? "SCHED_FIFO" :
+                           native == SCHED_RR ? "SCHED_RR" : "SCHED_OTHER";
+        return name + " priority " + std::to_string(param.sched_priority) 
+               + ", nice " + std::to_string(nice) + ", on CPU " + std::to_string(sched_getcpu());
+    }
     
     void displayAttributes() const {
         std::cout << "Thread Attributes:\n";
@@ -151,9 +679,138 @@ public:
                                     policy == POLICY_RR ? "Round Robin" : "Other") << "\n";
         std::cout << "  Scope: " << (scope == SCOPE_PROCESS ? "Process" : "System") << "\n";
         std::cout << "  Priority: " << priority << "\n";
+        std::cout << "  Nice: " << nice_value << "\n";
+        std::cout << "  CPU Affinity: ";
+        if (cpu_affinity.empty()) {
+            std::cout << "any";
+        }
+        for (size_t i = 0; i < cpu_affinity.size(); i++) {
+            std::cout << cpu_affinity[i] << (i + 1 < cpu_affinity.size() ? ", " : "");
+        }
+        std::cout << "\n";
     }
 };
 
+// Wakeup jitter: a thread sleeps to absolute 1 ms deadlines and records how
+// late it wakes, while one busy-looping SCHED_OTHER thread per CPU competes
+void benchmarkWakeupJitter(ThreadAttributes::SchedulingPolicy policy, int samples) {
+    std::atomic<bool> load_running{true};
+    std::vector<std::thread> background;
+    int num_cpus = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < num_cpus; i++) {
+        background.emplace_back([&load_running] {
+            volatile unsigned long spin = 0;
+            while (load_running.load(std::memory_order_relaxed)) spin++;
+        });
+    }
+    
+    ThreadAttributes attr;
+    attr.setSchedulingPolicy(policy);
+    attr.setPriority(80);
+    
+    std::vector<long long> lateness_ns;
+    lateness_ns.reserve(samples);
+    std::string effective;
+    
+    ThreadAttributes::Thread sampler = attr.launch([&] {
+        effective = ThreadAttributes::describeCurrentThread();
+        timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        for (int i = 0; i < samples; i++) {
+            deadline.tv_nsec += 1000000;
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_nsec -= 1000000000;
+                deadline.tv_sec++;
+            }
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr);
+            
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            lateness_ns.push_back((now.tv_sec - deadline.tv_sec) * 1000000000LL 
+                                  + (now.tv_nsec - deadline.tv_nsec));
+        }
+    });
+    sampler.join();
+    
+    load_running = false;
+    for (auto& t : background) {
+        t.join();
+    }
+    
+    std::sort(lateness_ns.begin(), lateness_ns.end());
+    long long total = 0;
+    for (long long ns : lateness_ns) total += ns;
+    
+    std::cout << "Requested " << (policy == ThreadAttributes::POLICY_FIFO ? "SCHED_FIFO" : "SCHED_OTHER")
+              << ", ran as " << effective << "\n";
+    std::cout << "  Wakeup lateness (us): avg " << total / 1000.0 / samples
+              << ", p50 " << lateness_ns[samples / 2] / 1000.0
+              << ", p99 " << lateness_ns[samples * 99 / 100] / 1000.0
+              << ", max " << lateness_ns.back() / 1000.0 << "\n";
+}
+
+// Dispatch benchmark: zero-burst threads with random priorities 0-7
+void benchmarkDispatcher(int num_workers, int num_threads) {
+    ThreadScheduler scheduler(1); // age one level per millisecond of waiting
+    scheduler.setVerbose(false);
+    scheduler.start(num_workers);
+    
+    unsigned int seed = 42;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_threads; i++) {
+        seed = seed * 1103515245u + 12345u;
+        scheduler.addThread(ThreadInfo(i, (seed >> 16) % 8, 0));
+    }
+    scheduler.waitForCompletion();
+    auto end = std::chrono::steady_clock::now();
+    
+    scheduler.stop();
+    scheduler.join();
+    
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "\nWorkers: " << num_workers << ", Threads: " << num_threads
+              << ", Dispatch throughput: " << static_cast<long long>(num_threads / seconds) << "/sec\n";
+    scheduler.displayLatencyByPriority();
+}
+
+// Random arrivals (0-49 ms apart, bursts 1-5, priorities 0-7) on the
+// virtual or real clock. Returns the virtual-time trace hash.
+uint64_t runSchedulingExperiment(bool virtual_time, int num_workers, int num_threads, unsigned int seed) {
+    ThreadScheduler scheduler;
+    scheduler.setVerbose(false);
+    if (virtual_time) scheduler.useVirtualTime();
+    scheduler.start(num_workers);
+    scheduler.enterAsSubmitter();
+    
+    auto start = std::chrono::steady_clock::now();
+    long long first_arrival = scheduler.nowNs();
+    for (int i = 0; i < num_threads; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int priority = (seed >> 16) % 8;
+        seed = seed * 1103515245u + 12345u;
+        int burst = 1 + (seed >> 16) % 5;
+        seed = seed * 1103515245u + 12345u;
+        scheduler.pause((seed >> 16) % 50);
+        scheduler.addThread(ThreadInfo(i, priority, burst));
+    }
+    scheduler.waitForCompletion();
+    long long makespan_ns = scheduler.nowNs() - first_arrival;
+    auto end = std::chrono::steady_clock::now();
+    
+    scheduler.stop();
+    scheduler.join();
+    
+    std::cout << (virtual_time ? "\nVirtual" : "\nReal") << " time, Workers: " << num_workers 
+              << ", Threads: " << num_threads << ", Makespan: " << makespan_ns / 1000000 << "ms"
+              << ", Wall time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << "ms";
+    if (virtual_time) {
+        std::cout << ", Trace hash: " << std::hex << scheduler.getTraceHash() << std::dec;
+    }
+    std::cout << "\n";
+    scheduler.displayLatencyByPriority();
+    return scheduler.getTraceHash();
+}
+
 // Demo worker thread function
 void workerThread(int id, int work_time) {
     std::cout << "Worker Thread " << id << " starting work for " << work_time << "ms\n";
@@ -176,8 +833,8 @@ int main() {
         
         ThreadScheduler scheduler;
         
-        // Start scheduler in separate thread
-        std::thread scheduler_thread(&ThreadScheduler::scheduler, &scheduler);
+        // Start two dispatcher workers
+        scheduler.start(2);
         
         // Create and schedule threads with different priorities
         scheduler.addThread(ThreadInfo(1, 3, 5));  // Medium priority
@@ -188,19 +845,32 @@ int main() {
         // Wait for all threads to complete properly
         scheduler.waitForCompletion();
         
-        // Stop the scheduler and wait for scheduler thread to finish
+        // Stop the scheduler and wait for the dispatcher threads to finish
         scheduler.stop();
-        if (scheduler_thread.joinable()) {
-            scheduler_thread.join();
-        }
+        scheduler.join();
+        std::cout << "Scheduler stopped. Total threads completed: " << scheduler.getCompletedThreadsCount() << "\n";
         
         std::cout << "\n=== PTHREAD STYLE THREADS ===\n";
         
-        // Create multiple worker threads
-        std::vector<std::thread> workers;
+        // Create multiple worker threads: two real-time (attr above), two
+        // SCHED_OTHER with increasing nice values
+        std::vector<ThreadAttributes::Thread> workers;
+        std::mutex output_mutex;
         
         for (int i = 1; i <= 4; i++) {
-            workers.emplace_back(workerThread, i, i * 200);
+            ThreadAttributes worker_attr = attr;
+            if (i > 2) {
+                worker_attr.setSchedulingPolicy(ThreadAttributes::POLICY_OTHER);
+                worker_attr.setNiceValue(i * 2);
+            }
+            workers.push_back(worker_attr.launch([i, &output_mutex] {
+                {
+                    std::lock_guard<std::mutex> lock(output_mutex);
+                    std::cout << "Worker Thread " << i << " running as " 
+                              << ThreadAttributes::describeCurrentThread() << "\n";
+                }
+                workerThread(i, i * 200);
+            }));
         }
         
         // Wait for all workers to complete
@@ -210,6 +880,22 @@ int main() {
             }
         }
         
+        std::cout << "\n=== WAKEUP JITTER UNDER LOAD (1 ms period) ===\n";
+        benchmarkWakeupJitter(ThreadAttributes::POLICY_OTHER, 1000);
+        benchmarkWakeupJitter(ThreadAttributes::POLICY_FIFO, 1000);
+        
+        std::cout << "\n=== DISPATCHER BENCHMARK ===";
+        for (int num_workers : {1, 4}) {
+            benchmarkDispatcher(num_workers, 200000);
+        }
+        
+        std::cout << "\n=== VIRTUAL TIME vs REAL TIME ===";
+        runSchedulingExperiment(false, 2, 12, 7);
+        runSchedulingExperiment(true, 2, 12, 7);
+        uint64_t first = runSchedulingExperiment(true, 16, 20000, 7);
+        uint64_t second = runSchedulingExperiment(true, 16, 20000, 7);
+        std::cout << "Same seed, identical schedules: " << (first == second ? "yes" : "NO") << "\n";
+        
         std::cout << "\nAll threads completed!\n";
         std::cout << "Scheduler processed " << scheduler.getCompletedThreadsCount() 
                   << " out of " << scheduler.getSubmittedThreadsCount() << " threads.\n";
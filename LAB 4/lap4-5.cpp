@@ -13,6 +13,19 @@
 #include <algorithm>
 #include <climits>
 #include <memory>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#include "sched_sync.h"
 
 class Task {
 public:
@@ -22,6 +35,9 @@ public:
     std::chrono::steady_clock::time_point arrival_time;
     std::chrono::steady_clock::time_point start_time;
     std::chrono::steady_clock::time_point completion_time;
+    size_t data_bytes = 0; // working set, allocated when the task is submitted
+    void* data = nullptr;
+    int data_node = -1;    // NUMA node the data was placed on, -1 if unknown
     
     Task(int id, int burst, int cpu = -1) 
         : task_id(id), burst_time(burst), preferred_cpu(cpu) {
@@ -29,62 +45,621 @@ public:
     }
 };
 
+// Real CPU/NUMA layout of the host, read from sysfs
+class HostTopology {
+public:
+    struct Node {
+        int node_id;
+        std::vector<int> cpus;
+        std::vector<int> distances; // SLIT distance to every node, 10 = local
+    };
+    
+    std::vector<int> online_cpus;
+    std::vector<Node> nodes;
+    
+    // Parses kernel cpu/node lists such as "0-3,8,10-11"
+    static std::vector<int> parseList(const std::string& list) {
+        std::vector<int> result;
+        std::stringstream ss(list);
+        std::string range;
+        while (std::getline(ss, range, ',')) {
+            if (range.empty() || range[0] == '\n') continue;
+            size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+            for (int i = first; i <= last; i++) {
+                result.push_back(i);
+            }
+        }
+        return result;
+    }
+    
+    static std::string readLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+    
+    static HostTopology detect() {
+        HostTopology topo;
+        topo.online_cpus = parseList(readLine("/sys/devices/system/cpu/online"));
+        if (topo.online_cpus.empty()) {
+            int count = std::max(1u, std::thread::hardware_concurrency());
+            for (int i = 0; i < count; i++) topo.online_cpus.push_back(i);
+        }
+        
+        for (int node_id : parseList(readLine("/sys/devices/system/node/online"))) {
+            std::string dir = "/sys/devices/system/node/node" + std::to_string(node_id);
+            Node node{node_id, parseList(readLine(dir + "/cpulist")), {}};
+            
+            std::stringstream distances(readLine(dir + "/distance"));
+            int distance;
+            while (distances >> distance) {
+                node.distances.push_back(distance);
+            }
+            topo.nodes.push_back(node);
+        }
+        
+        // No NUMA information (non-NUMA kernel or sysfs not mounted)
+        if (topo.nodes.empty()) {
+            topo.nodes.push_back({0, topo.online_cpus, {10}});
+        }
+        return topo;
+    }
+    
+    int nodeOfCpu(int cpu) const {
+        for (size_t n = 0; n < nodes.size(); n++) {
+            for (int c : nodes[n].cpus) {
+                if (c == cpu) return static_cast<int>(n);
+            }
+        }
+        return -1;
+    }
+    
+    void display() const {
+        std::cout << "\n=== HOST TOPOLOGY ===\n";
+        std::cout << "Online CPUs: " << online_cpus.size() << "\n";
+        for (const auto& node : nodes) {
+            std::cout << "Node " << node.node_id << ": CPUs [";
+            for (size_t i = 0; i < node.cpus.size(); i++) {
+                std::cout << node.cpus[i];
+                if (i < node.cpus.size() - 1) std::cout << ", ";
+            }
+            std::cout << "], Distances [";
+            for (size_t i = 0; i < node.distances.size(); i++) {
+                std::cout << node.distances[i];
+                if (i < node.distances.size() - 1) std::cout << ", ";
+            }
+            std::cout << "]\n";
+        }
+    }
+};
+
+// Pins the calling thread to one host CPU
+bool pinCurrentThread(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// Memory placement for task data. allocate() maps anonymous memory and, if
+// a node is given, binds it there with mbind(MPOL_BIND); otherwise pages
+// land on the node of whichever thread touches them first.
+class NUMAMemory {
+public:
+    static void* allocate(size_t bytes, int node = -1) {
+        void* addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) return nullptr;
+        if (node >= 0) {
+            bindToNode(addr, bytes, node);
+        }
+        return addr;
+    }
+    
+    static bool bindToNode(void* addr, size_t bytes, int node) {
+        unsigned long nodemask[16] = {0};
+        if (node < 0 || node >= static_cast<int>(sizeof(nodemask) * 8)) return false;
+        nodemask[node / (sizeof(unsigned long) * 8)] |= 1UL << (node % (sizeof(unsigned long) * 8));
+        
+        // Called through syscall() so that no libnuma is needed at link time
+        return syscall(SYS_mbind, addr, bytes, MPOL_BIND, nodemask,
+                       sizeof(nodemask) * 8, 0) == 0;
+    }
+    
+    // Touch every page from the calling thread so first-touch places it
+    static void firstTouch(void* addr, size_t bytes) {
+        long page = sysconf(_SC_PAGESIZE);
+        char* p = static_cast<char*>(addr);
+        for (size_t off = 0; off < bytes; off += page) {
+            p[off] = 0;
+        }
+    }
+    
+    // Read one word per cache line, as a task working on its data would
+    static uint64_t sweep(const void* addr, size_t bytes) {
+        const uint64_t* p = static_cast<const uint64_t*>(addr);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < bytes / sizeof(uint64_t); i += 8) {
+            sum += p[i];
+        }
+        return sum;
+    }
+    
+    static void release(void* addr, size_t bytes) {
+        if (addr) munmap(addr, bytes);
+    }
+};
+
+// Chase-Lev work-stealing deque. The owning core pushes and pops at the
+// bottom; other cores steal from the top. No locks are taken on either side.
+// Replaced buffers are kept until destruction because a thief may still be
+// reading from one.
+template <typename T>
+class WorkStealingDeque {
+private:
+    struct Buffer {
+        int64_t capacity;
+        int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+        
+        explicit Buffer(int64_t cap) 
+            : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[cap]) {}
+        
+        T get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T item) { slots[i & mask].store(item, std::memory_order_relaxed); }
+        
+        Buffer* grow(int64_t bottom, int64_t top) const {
+            Buffer* bigger = new Buffer(capacity * 2);
+            for (int64_t i = top; i < bottom; i++) {
+                bigger->put(i, get(i));
+            }
+            return bigger;
+        }
+    };
+    
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<Buffer*> buffer;
+    std::vector<std::unique_ptr<Buffer>> retired_buffers;
+    
+public:
+    explicit WorkStealingDeque(int64_t capacity = 64) : buffer(new Buffer(capacity)) {}
+    
+    ~WorkStealingDeque() {
+        delete buffer.load(std::memory_order_relaxed);
+    }
+    
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    
+    // Owner only
+    void push(T item) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* buf = buffer.load(std::memory_order_relaxed);
+        
+        if (b - t > buf->capacity - 1) {
+            retired_buffers.emplace_back(buf);
+            buf = buf->grow(b, t);
+            buffer.store(buf, std::memory_order_release);
+        }
+        
+        buf->put(b, item);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+    
+    // Owner only
+    bool pop(T& item) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buf = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        
+        if (t > b) {
+            // Deque was empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        
+        item = buf->get(b);
+        if (t == b) {
+            // Last element - race against thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+    
+    // Any thread
+    bool steal(T& item) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        
+        if (t >= b) return false;
+        
+        Buffer* buf = buffer.load(std::memory_order_acquire);
+        item = buf->get(t);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed);
+    }
+    
+    int64_t size() const {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+};
+
 class CPUCore {
+private:
+    struct TaskNode {
+        Task task;
+        TaskNode* next;
+        
+        TaskNode(const Task& t) : task(t), next(nullptr) {}
+    };
+    
+    // Tasks handed to this core by other threads land in the inbox (a
+    // lock-free stack) and are moved into the deque by the owner, since only
+    // the owner may push to the bottom of a Chase-Lev deque.
+    std::atomic<TaskNode*> inbox{nullptr};
+    WorkStealingDeque<TaskNode*> local_queue;
+    
+    // Detaches the whole inbox, returned oldest-first
+    TaskNode* takeInbox() {
+        TaskNode* node = inbox.exchange(nullptr, std::memory_order_acquire);
+        
+        // The stack is newest-first; reverse to keep submission order
+        TaskNode* ordered = nullptr;
+        while (node) {
+            TaskNode* next = node->next;
+            node->next = ordered;
+            ordered = node;
+            node = next;
+        }
+        return ordered;
+    }
+    
+    void pushInbox(TaskNode* node) {
+        node->next = inbox.load(std::memory_order_relaxed);
+        while (!inbox.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+        }
+    }
+    
+    void drainInbox() {
+        TaskNode* ordered = takeInbox();
+        while (ordered) {
+            TaskNode* next = ordered->next;
+            local_queue.push(ordered);
+            ordered = next;
+        }
+    }
+    
 public:
     int core_id;
-    std::queue<Task> local_queue;
-    std::mutex queue_mutex;
     std::atomic<bool> is_busy{false};
     std::atomic<int> load{0};
+    uint32_t rng_state; // owner only, used for victim selection
+    
+    CPUCore(int id) : core_id(id), rng_state(2654435761u * (id + 1)) {}
     
-    CPUCore(int id) : core_id(id) {}
+    ~CPUCore() {
+        TaskNode* node = inbox.exchange(nullptr);
+        while (node) {
+            TaskNode* next = node->next;
+            delete node;
+            node = next;
+        }
+        while (local_queue.pop(node)) {
+            delete node;
+        }
+    }
     
-    // Delete copy constructor and assignment operator due to mutex
+    // Delete copy constructor and assignment operator due to atomics
     CPUCore(const CPUCore&) = delete;
     CPUCore& operator=(const CPUCore&) = delete;
     
+    // Any thread
     void addTask(const Task& task) {
-        std::lock_guard<std::mutex> lock(queue_mutex);
-        local_queue.push(task);
-        load++;
+        pushInbox(new TaskNode(task));
+        load.fetch_add(1, std::memory_order_relaxed);
     }
     
+    // Any thread - moves up to max_tasks queued tasks (oldest first) into
+    // target's inbox. Used by the load balancer, which owns neither core.
+    int migrateTo(CPUCore& target, int max_tasks) {
+        int moved = 0;
+        TaskNode* node;
+        
+        while (moved < max_tasks && local_queue.steal(node)) {
+            target.pushInbox(node);
+            moved++;
+        }
+        
+        if (moved < max_tasks && inbox.load(std::memory_order_relaxed)) {
+            node = takeInbox();
+            while (node && moved < max_tasks) {
+                TaskNode* next = node->next;
+                target.pushInbox(node);
+                node = next;
+                moved++;
+            }
+            // Hand back what the batch did not need
+            while (node) {
+                TaskNode* next = node->next;
+                pushInbox(node);
+                node = next;
+            }
+        }
+        
+        if (moved > 0) {
+            load.fetch_sub(moved, std::memory_order_relaxed);
+            target.load.fetch_add(moved, std::memory_order_relaxed);
+        }
+        return moved;
+    }
+    
+    // Owner only - xorshift32, cheap enough to call on every steal attempt
+    uint32_t nextRandom() {
+        rng_state ^= rng_state << 13;
+        rng_state ^= rng_state >> 17;
+        rng_state ^= rng_state << 5;
+        return rng_state;
+    }
+    
+    // Owner only - takes the most recently queued task
     bool getTask(Task& task) {
-        std::lock_guard<std::mutex> lock(queue_mutex);
-        if (!local_queue.empty()) {
-            task = local_queue.front();
-            local_queue.pop();
-            load--;
-            return true;
+        if (inbox.load(std::memory_order_relaxed)) {
+            drainInbox();
         }
-        return false;
+        
+        TaskNode* node;
+        if (!local_queue.pop(node)) return false;
+        
+        task = node->task;
+        delete node;
+        load.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    
+    // Thief's thread - steals up to max_tasks from the top of the deque,
+    // returning the first in task and queueing the rest on the thief. If the
+    // deque is empty, takes up to max_tasks of what the owner has not drained
+    // from its inbox yet. Returns the number of tasks taken.
+    int stealBatch(CPUCore& thief, int max_tasks, Task& task) {
+        int taken = 0;
+        TaskNode* node;
+        
+        while (taken < max_tasks && local_queue.steal(node)) {
+            if (taken == 0) {
+                task = node->task;
+                delete node;
+            } else {
+                thief.local_queue.push(node);
+            }
+            taken++;
+        }
+        
+        if (taken == 0 && inbox.load(std::memory_order_relaxed)) {
+            node = takeInbox();
+            while (node && taken < max_tasks) {
+                TaskNode* next = node->next;
+                if (taken == 0) {
+                    task = node->task;
+                    delete node;
+                } else {
+                    thief.local_queue.push(node);
+                }
+                taken++;
+                node = next;
+            }
+            // Hand back what the batch did not need
+            while (node) {
+                TaskNode* next = node->next;
+                pushInbox(node);
+                node = next;
+            }
+        }
+        
+        if (taken > 0) {
+            load.fetch_sub(taken, std::memory_order_relaxed);
+            thief.load.fetch_add(taken - 1, std::memory_order_relaxed);
+        }
+        return taken;
+    }
+    
+    int getQueueSize() const {
+        return load.load(std::memory_order_relaxed);
+    }
+    
+    bool isEmpty() const {
+        return getQueueSize() == 0;
+    }
+};
+
+// NUMA-aware scheduler simulation
+class NUMAScheduler {
+private:
+    struct NUMANode {
+        int node_id;
+        std::vector<int> cpu_cores;
+        int memory_latency; // Access latency in nanoseconds
+        
+        NUMANode(int id, std::vector<int> cores, int latency) 
+            : node_id(id), cpu_cores(std::move(cores)), memory_latency(latency) {}
+    };
+    
+    std::vector<NUMANode> numa_nodes;
+    
+public:
+    NUMAScheduler() {
+        // Simulate 2 NUMA nodes
+        numa_nodes.emplace_back(0, std::vector<int>{0, 1}, 100); // Local access
+        numa_nodes.emplace_back(1, std::vector<int>{2, 3}, 300); // Remote access
     }
     
-    int getQueueSize() {
-        std::lock_guard<std::mutex> lock(queue_mutex);
-        return static_cast<int>(local_queue.size());
+    // Simulate num_nodes nodes with consecutive core ids
+    NUMAScheduler(int num_nodes, int cores_per_node) {
+        for (int n = 0; n < num_nodes; n++) {
+            std::vector<int> node_cores;
+            for (int c = 0; c < cores_per_node; c++) {
+                node_cores.push_back(n * cores_per_node + c);
+            }
+            numa_nodes.emplace_back(n, std::move(node_cores), n == 0 ? 100 : 300);
+        }
+    }
+    
+    // Real topology; latency is derived from the SLIT distance to node 0
+    // (10 = local, ~100ns)
+    NUMAScheduler(const HostTopology& host) {
+        for (const auto& node : host.nodes) {
+            int distance = node.distances.empty() ? 10 : node.distances[0];
+            numa_nodes.emplace_back(node.node_id, node.cpus, distance * 10);
+        }
+    }
+    
+    int getNodeCount() const {
+        return static_cast<int>(numa_nodes.size());
+    }
+    
+    const std::vector<int>& getNodeCores(int node_id) const {
+        return numa_nodes[node_id].cpu_cores;
+    }
+    
+    // core_loads[i] is the number of tasks on core i; cores outside it are
+    // skipped. With no loads the first core of the chosen node is returned.
+    int selectOptimalCore(int preferred_node = -1, const std::vector<int>& core_loads = {}) {
+        if (preferred_node >= 0 && preferred_node < static_cast<int>(numa_nodes.size())) {
+            int core = leastLoadedCore(numa_nodes[preferred_node], core_loads);
+            if (core >= 0) return core;
+        }
+        
+        // Find node with lowest memory latency that has available cores
+        int best_core = -1;
+        int min_latency = INT_MAX;
+        
+        for (const auto& node : numa_nodes) {
+            int core = leastLoadedCore(node, core_loads);
+            if (core >= 0 && node.memory_latency < min_latency) {
+                min_latency = node.memory_latency;
+                best_core = core;
+            }
+        }
+        
+        return best_core >= 0 ? best_core : numa_nodes[0].cpu_cores[0];
     }
     
-    bool isEmpty() {
-        std::lock_guard<std::mutex> lock(queue_mutex);
-        return local_queue.empty();
+private:
+    static int leastLoadedCore(const NUMANode& node, const std::vector<int>& core_loads) {
+        if (core_loads.empty()) {
+            return node.cpu_cores.empty() ? -1 : node.cpu_cores[0];
+        }
+        
+        int best_core = -1;
+        int min_load = INT_MAX;
+        for (int core : node.cpu_cores) {
+            if (core < 0 || core >= static_cast<int>(core_loads.size())) continue;
+            if (core_loads[core] < min_load) {
+                min_load = core_loads[core];
+                best_core = core;
+            }
+        }
+        return best_core;
+    }
+    
+public:
+    
+    void displayNUMATopology() {
+        std::cout << "\n=== NUMA TOPOLOGY ===\n";
+        for (const auto& node : numa_nodes) {
+            std::cout << "NUMA Node " << node.node_id 
+                      << ": CPUs [";
+            for (size_t i = 0; i < node.cpu_cores.size(); i++) {
+                std::cout << node.cpu_cores[i];
+                if (i < node.cpu_cores.size() - 1) std::cout << ", ";
+            }
+            std::cout << "], Memory Latency: " << node.memory_latency << "ns\n";
+        }
     }
 };
 
 class MultiProcessorScheduler {
 private:
     std::vector<std::unique_ptr<CPUCore>> cores;
-    std::queue<Task> global_queue;
-    std::mutex global_mutex;
-    std::condition_variable cv;
+    std::atomic<unsigned> next_submit_core{0}; // round-robin cursor for tasks without affinity
     std::atomic<bool> running{true};
     std::atomic<int> active_tasks{0};
     std::atomic<int> completed_tasks{0};
+    EventCount idle_event;
     int num_cores;
+    bool verbose = true;
+    
+    // Dispatch latency = time from Task creation to start of execution
+    std::atomic<long long> total_dispatch_ns{0};
+    std::atomic<long long> max_dispatch_ns{0};
+    
+    // Task data reads, split by whether the executing core is on the node
+    // the data was placed on at submission
+    std::atomic<long long> data_bytes_read{0};
+    std::atomic<long long> local_data_reads{0};
+    std::atomic<long long> remote_data_reads{0};
+    std::atomic<uint64_t> data_checksum{0};
+    
+    // Work stealing statistics
+    std::atomic<long long> steal_attempts{0};
+    std::atomic<long long> steal_successes{0};
+    std::atomic<long long> stolen_tasks{0};
+    
+    // Load imbalance (max - min queue length) sampled over time
+    struct ImbalanceSample {
+        long long time_ms;
+        int imbalance;
+    };
+    std::vector<ImbalanceSample> imbalance_samples;
+    std::mutex samples_mutex;
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    
+    // Event-driven load balancing: the balancer sleeps until a core goes
+    // idle or a queue crosses HIGH_WATERMARK
+    EventCount balance_event;
+    std::atomic<bool> balance_requested{false};
+    std::atomic<long long> imbalance_start_ns{0}; // 0 = currently balanced
+    std::atomic<long long> balance_episodes{0};
+    std::atomic<long long> total_time_to_balance_ns{0};
+    std::atomic<long long> max_time_to_balance_ns{0};
+    std::atomic<long long> balance_rounds{0};
+    std::atomic<long long> balancer_migrated_tasks{0};
+    std::atomic<long long> migration_ns{0};
+    
+    // Host CPU each simulated core's thread is pinned to (empty = unpinned)
+    std::vector<int> host_cpus;
+    
+    // Locality bias: victims are drawn from the thief's NUMA node first
+    bool locality_bias = false;
+    std::vector<std::vector<int>> local_peers; // core -> other cores on its node
+    std::vector<int> core_node;                // core -> its NUMA node (empty = unknown)
     
     // Load balancing parameters
     static constexpr int LOAD_BALANCE_THRESHOLD = 2;
     static constexpr int MIGRATION_COST = 5; // milliseconds
+    static constexpr int STEAL_ROUNDS = 2;   // random victim pairs tried per steal
+    static constexpr int HIGH_WATERMARK = 8; // queue length that triggers balancing
+    
+    // Virtual-time mode: core threads are actors 0..num_cores-1 and the
+    // submitting thread is actor num_cores. Bursts advance the clock instead
+    // of sleeping, and balancing runs inline on the core that requests it.
+    bool virtual_time = false;
+    std::unique_ptr<VirtualClock> clock;
+    bool submitter_finished = false;
+    uint64_t trace_hash = 14695981039346656037ull; // FNV-1a over (task, core, start)
     
 public:
     MultiProcessorScheduler(int cores_count) : num_cores(cores_count) {
@@ -94,21 +669,155 @@ public:
         }
     }
     
-    void addTask(const Task& task) {
-        if (task.preferred_cpu >= 0 && task.preferred_cpu < num_cores) {
-            // Processor affinity - try preferred CPU first
-            cores[task.preferred_cpu]->addTask(task);
+    void setVerbose(bool enabled) { verbose = enabled; }
+    
+    // Run on a simulated clock; call before starting any threads. The
+    // thread that calls addTask() must then call enterAsSubmitter().
+    void useVirtualTime() {
+        virtual_time = true;
+        clock = std::make_unique<VirtualClock>(num_cores + 1);
+    }
+    
+    void enterAsSubmitter() {
+        if (virtual_time) clock->start(num_cores);
+    }
+    
+    // Delays the submitting thread, on whichever clock is in use
+    void pause(int ms) {
+        if (virtual_time) {
+            clock->sleepFor(num_cores, ms * 1000000LL);
         } else {
-            // Global queue for load balancing
-            std::lock_guard<std::mutex> lock(global_mutex);
-            global_queue.push(task);
+            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        }
+    }
+    
+    // Order-sensitive hash of every dispatch; identical across virtual-time
+    // runs with the same input
+    uint64_t getTraceHash() const { return trace_hash; }
+    
+    // Core i will run on cpus[i % cpus.size()]; call before starting threads
+    void pinToHostCpus(const std::vector<int>& cpus) { host_cpus = cpus; }
+    
+    // Queued tasks plus the one running, per core
+    std::vector<int> getCoreLoads() const {
+        std::vector<int> loads(num_cores);
+        for (int i = 0; i < num_cores; i++) {
+            loads[i] = cores[i]->getQueueSize() + (cores[i]->is_busy.load() ? 1 : 0);
+        }
+        return loads;
+    }
+    
+    // Prefer stealing from cores on the same NUMA node. Also records each
+    // core's node, which places task data at submission.
+    void setLocalityBias(const NUMAScheduler& numa) {
+        local_peers.assign(num_cores, std::vector<int>());
+        core_node.assign(num_cores, -1);
+        for (int n = 0; n < numa.getNodeCount(); n++) {
+            const std::vector<int>& node_cores = numa.getNodeCores(n);
+            for (int core : node_cores) {
+                if (core < 0 || core >= num_cores) continue;
+                core_node[core] = n;
+                for (int peer : node_cores) {
+                    if (peer != core && peer >= 0 && peer < num_cores) {
+                        local_peers[core].push_back(peer);
+                    }
+                }
+            }
         }
+        locality_bias = true;
+    }
+    
+    void addTask(const Task& submitted) {
+        Task task = submitted;
+        if (virtual_time) {
+            task.arrival_time = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(nowNs()));
+        }
+        
         active_tasks++;
-        cv.notify_all();
+        // Processor affinity - try preferred CPU first
+        int target = (task.preferred_cpu >= 0 && task.preferred_cpu < num_cores) ? task.preferred_cpu
+                                                                                : pickSubmitCore();
+        
+        // Place the task's data on the target core's node now; if the task is
+        // stolen or migrated to another node later, it reads it remotely. On
+        // a host with fewer nodes than simulated, mbind fails and the pages
+        // fall back to first touch.
+        if (task.data_bytes > 0 && !task.data) {
+            task.data_node = core_node.empty() ? -1 : core_node[target];
+            task.data = NUMAMemory::allocate(task.data_bytes, task.data_node);
+            if (task.data) NUMAMemory::firstTouch(task.data, task.data_bytes);
+        }
+        cores[target]->addTask(task);
+        if (cores[target]->getQueueSize() > HIGH_WATERMARK) {
+            long long not_started = 0;
+            imbalance_start_ns.compare_exchange_strong(not_started, std::max(1LL, nowNs()));
+            requestBalance();
+        }
+        wakeIdleCores();
+    }
+    
+    // Tasks without affinity go straight into a core's inbox instead of a
+    // shared queue: the less loaded of the next two cores in round-robin
+    // order. Idle cores pick them up from there by stealing.
+    int pickSubmitCore() {
+        unsigned slot = next_submit_core.fetch_add(2, std::memory_order_relaxed);
+        int first = static_cast<int>(slot % num_cores);
+        int second = static_cast<int>((slot + 1) % num_cores);
+        return cores[second]->getQueueSize() < cores[first]->getQueueSize() ? second : first;
+    }
+    
+    static long long wallNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>
+            (std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    // Simulated time in virtual mode, wall-clock time otherwise
+    long long nowNs() const {
+        return virtual_time ? clock->now() : wallNs();
+    }
+    
+    void wakeIdleCores() {
+        if (virtual_time) {
+            clock->wakeIdle();
+        } else {
+            idle_event.notifyAll();
+        }
+    }
+    
+    // Cheap enough to call from every idle iteration: only the first
+    // request after the balancer wakes up touches the eventcount
+    void requestBalance() {
+        if (virtual_time) {
+            rebalance(); // no balancer thread; only this actor is running
+            return;
+        }
+        if (!balance_requested.load(std::memory_order_relaxed) &&
+            !balance_requested.exchange(true)) {
+            balance_event.notifyAll();
+        }
+    }
+    
+    // True if core_id could pick something up right now; reads only the
+    // per-core load counters
+    bool hasPendingWork(int core_id) {
+        if (!cores[core_id]->isEmpty()) return true;
+        for (int i = 0; i < num_cores; i++) {
+            if (i != core_id && !cores[i]->isEmpty()) return true;
+        }
+        return false;
     }
     
     void cpuScheduler(int core_id) {
-        std::cout << "CPU Core " << core_id << " scheduler started\n";
+        if (!host_cpus.empty()) {
+            int cpu = host_cpus[core_id % host_cpus.size()];
+            if (!pinCurrentThread(cpu)) {
+                std::cout << "CPU Core " << core_id << ": could not pin to host CPU " << cpu << "\n";
+            } else if (verbose) {
+                std::cout << "CPU Core " << core_id << " pinned to host CPU " << cpu << "\n";
+            }
+        }
+        if (verbose) std::cout << "CPU Core " << core_id << " scheduler started\n";
+        if (virtual_time) clock->start(core_id);
         
         while (running.load() || active_tasks.load() > 0) {
             Task current_task(0, 0);
@@ -118,15 +827,6 @@ public:
             if (cores[core_id]->getTask(current_task)) {
                 has_task = true;
             }
-            // Try global queue
-            else {
-                std::lock_guard<std::mutex> lock(global_mutex);
-                if (!global_queue.empty()) {
-                    current_task = global_queue.front();
-                    global_queue.pop();
-                    has_task = true;
-                }
-            }
             
             // Work stealing - try to steal from other cores
             if (!has_task) {
@@ -135,63 +835,194 @@ public:
             
             if (has_task) {
                 executeTask(core_id, current_task);
-            } else {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+            
+            // This core went idle - let the balancer even things out
+            requestBalance();
+            
+            if (virtual_time) {
+                if (hasPendingWork(core_id)) {
+                    clock->sleepFor(core_id, 0); // retry after the other actors at this instant
+                } else if (running.load() || active_tasks.load() > 0) {
+                    clock->waitIdle(core_id);
+                }
+                continue;
+            }
+            
+            // Park until new work is published or the scheduler shuts down
+            uint64_t key = idle_event.prepareWait();
+            if (hasPendingWork(core_id)) {
+                // Random probes missed the loaded core; let its owner run
+                idle_event.cancelWait();
+                std::this_thread::yield();
+                continue;
+            }
+            if (!running.load() && active_tasks.load() == 0) {
+                idle_event.cancelWait();
+                continue;
             }
+            idle_event.wait(key);
         }
         
-        std::cout << "CPU Core " << core_id << " scheduler stopped\n";
+        if (virtual_time) clock->finish(core_id);
+        if (verbose) std::cout << "CPU Core " << core_id << " scheduler stopped\n";
+    }
+    
+    // Power-of-two-choices: probe two random cores and take the more
+    // loaded one, instead of scanning every core
+    int pickVictim(int core_id, const std::vector<int>* candidates) {
+        CPUCore& self = *cores[core_id];
+        int first, second;
+        
+        if (candidates) {
+            int n = static_cast<int>(candidates->size());
+            first = (*candidates)[self.nextRandom() % n];
+            second = (*candidates)[self.nextRandom() % n];
+        } else {
+            // Draw from the other num_cores - 1 cores
+            first = static_cast<int>(self.nextRandom() % (num_cores - 1));
+            second = static_cast<int>(self.nextRandom() % (num_cores - 1));
+            if (first >= core_id) first++;
+            if (second >= core_id) second++;
+        }
+        
+        return cores[first]->getQueueSize() >= cores[second]->getQueueSize() ? first : second;
     }
     
     bool workStealing(int core_id, Task& stolen_task) {
-        // Find the most loaded core
-        int max_load = 0;
-        int victim_core = -1;
+        if (num_cores < 2) return false;
         
-        for (int i = 0; i < num_cores; i++) {
-            if (i != core_id && cores[i]->getQueueSize() > max_load + LOAD_BALANCE_THRESHOLD) {
-                max_load = cores[i]->getQueueSize();
-                victim_core = i;
-            }
+        const std::vector<int>* local = nullptr;
+        if (locality_bias && !local_peers[core_id].empty()) {
+            local = &local_peers[core_id];
         }
         
-        if (victim_core != -1 && cores[victim_core]->getTask(stolen_task)) {
-            std::cout << "Core " << core_id << " stole task " << stolen_task.task_id 
-                      << " from Core " << victim_core << "\n";
+        for (int round = 0; round < STEAL_ROUNDS; round++) {
+            // With locality bias the first round stays on the local node
+            int victim_core = pickVictim(core_id, (round == 0) ? local : nullptr);
+            steal_attempts++; // every probe counts, including empty victims
+            int victim_load = cores[victim_core]->getQueueSize();
+            if (victim_load == 0) continue;
+            
+            // Steal half: run the first task, queue the rest locally
+            int batch = cores[victim_core]->stealBatch(*cores[core_id], (victim_load + 1) / 2, stolen_task);
+            if (batch == 0) continue;
+            
+            steal_successes++;
+            stolen_tasks += batch;
+            
+            if (verbose) {
+                std::cout << "Core " << core_id << " stole " << batch << " task(s) starting with Task "
+                          << stolen_task.task_id << " from Core " << victim_core << "\n";
+            }
             return true;
         }
         
         return false;
     }
     
+    int currentImbalance() const {
+        int min_load = INT_MAX;
+        int max_load = 0;
+        for (int i = 0; i < num_cores; i++) {
+            int load = cores[i]->getQueueSize();
+            min_load = std::min(min_load, load);
+            max_load = std::max(max_load, load);
+        }
+        return max_load - min_load;
+    }
+    
+    void recordImbalanceSample() {
+        long long now_ms = virtual_time ? nowNs() / 1000000 : std::chrono::duration_cast<std::chrono::milliseconds>
+            (std::chrono::steady_clock::now() - start_time).count();
+        int imbalance = currentImbalance();
+        std::lock_guard<std::mutex> lock(samples_mutex);
+        imbalance_samples.push_back({now_ms, imbalance});
+    }
+    
     void executeTask(int core_id, Task& task) {
         cores[core_id]->is_busy = true;
-        task.start_time = std::chrono::steady_clock::now();
+        task.start_time = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(nowNs()));
+        
+        long long dispatch_ns = std::chrono::duration_cast<std::chrono::nanoseconds>
+            (task.start_time - task.arrival_time).count();
+        total_dispatch_ns += dispatch_ns;
+        long long prev_max = max_dispatch_ns.load();
+        while (dispatch_ns > prev_max && !max_dispatch_ns.compare_exchange_weak(prev_max, dispatch_ns)) {
+        }
         
-        std::cout << "Core " << core_id << " executing Task " << task.task_id 
-                  << " (Burst: " << task.burst_time << "ms)\n";
+        if (verbose) {
+            std::cout << "Core " << core_id << " executing Task " << task.task_id 
+                      << " (Burst: " << task.burst_time << "ms)\n";
+        }
+        
+        // Work on the data placed at submission, from wherever the task
+        // ended up running
+        if (task.data) {
+            data_checksum += NUMAMemory::sweep(task.data, task.data_bytes);
+            data_bytes_read += task.data_bytes;
+            int node = core_node.empty() ? -1 : core_node[core_id];
+            if (node == task.data_node) {
+                local_data_reads++;
+            } else {
+                remote_data_reads++;
+            }
+        }
         
         // Simulate task execution
-        std::this_thread::sleep_for(std::chrono::milliseconds(task.burst_time));
+        if (virtual_time) {
+            trace_hash = (trace_hash ^ static_cast<uint64_t>(task.task_id)) * 1099511628211ull;
+            trace_hash = (trace_hash ^ static_cast<uint64_t>(core_id)) * 1099511628211ull;
+            trace_hash = (trace_hash ^ static_cast<uint64_t>(nowNs())) * 1099511628211ull;
+            clock->sleepFor(core_id, task.burst_time * 1000000LL);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(task.burst_time));
+        }
+        
+        NUMAMemory::release(task.data, task.data_bytes);
         
-        task.completion_time = std::chrono::steady_clock::now();
+        task.completion_time = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(nowNs()));
         
         auto turnaround_time = std::chrono::duration_cast<std::chrono::milliseconds>
             (task.completion_time - task.arrival_time);
         
-        std::cout << "Core " << core_id << " completed Task " << task.task_id 
-                  << " (Turnaround: " << turnaround_time.count() << "ms)\n";
+        if (verbose) {
+            std::cout << "Core " << core_id << " completed Task " << task.task_id 
+                      << " (Turnaround: " << turnaround_time.count() << "ms)\n";
+        }
         
         cores[core_id]->is_busy = false;
-        active_tasks--;
         completed_tasks++;
+        if (--active_tasks == 0) {
+            // Let parked cores re-check the shutdown condition
+            wakeIdleCores();
+        }
     }
     
     void loadBalancer() {
-        while (running.load()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            
-            // Check load imbalance
+        if (virtual_time) return; // balancing runs inline in requestBalance()
+        
+        while (true) {
+            uint64_t key = balance_event.prepareWait();
+            if (!running.load()) {
+                balance_event.cancelWait();
+                break;
+            }
+            if (!balance_requested.exchange(false)) {
+                balance_event.wait(key);
+                continue;
+            }
+            balance_event.cancelWait();
+            rebalance();
+        }
+    }
+    
+    // Moves half the difference between the longest and shortest queue per
+    // round until they are within LOAD_BALANCE_THRESHOLD. Loads are read
+    // from the cores' relaxed counters without taking any lock.
+    void rebalance() {
+        for (int round = 0; round < num_cores; round++) {
             int min_load = INT_MAX;
             int max_load = 0;
             int min_core = -1;
@@ -209,22 +1040,63 @@ public:
                 }
             }
             
-            // Migrate tasks if imbalance is significant
-            if (max_load - min_load > LOAD_BALANCE_THRESHOLD && max_core != -1 && min_core != -1) {
-                Task migrated_task(0, 0);
-                if (cores[max_core]->getTask(migrated_task)) {
-                    cores[min_core]->addTask(migrated_task);
-                    std::cout << "Load Balancer: Migrated Task " << migrated_task.task_id 
-                              << " from Core " << max_core << " to Core " << min_core << "\n";
-                }
+            if (max_load - min_load <= LOAD_BALANCE_THRESHOLD || max_core == min_core) {
+                markBalanced();
+                return;
+            }
+            
+            long long start = wallNs();
+            int moved = cores[max_core]->migrateTo(*cores[min_core], (max_load - min_load) / 2);
+            migration_ns += wallNs() - start;
+            if (moved == 0) return; // tasks already being taken; wait for the next event
+            
+            balance_rounds++;
+            balancer_migrated_tasks += moved;
+            wakeIdleCores();
+            
+            if (verbose) {
+                std::cout << "Load Balancer: Migrated " << moved << " task(s) from Core " 
+                          << max_core << " to Core " << min_core << "\n";
             }
         }
     }
     
+    void markBalanced() {
+        long long started = imbalance_start_ns.exchange(0);
+        if (started == 0) return;
+        
+        long long elapsed = nowNs() - started;
+        balance_episodes++;
+        total_time_to_balance_ns += elapsed;
+        long long prev_max = max_time_to_balance_ns.load();
+        while (elapsed > prev_max && !max_time_to_balance_ns.compare_exchange_weak(prev_max, elapsed)) {
+        }
+    }
+    
+    void displayBalancerStats() {
+        std::cout << "\n=== LOAD BALANCER STATISTICS ===\n";
+        long long rounds = balance_rounds.load();
+        long long migrated = balancer_migrated_tasks.load();
+        std::cout << "Balancing rounds: " << rounds << ", Tasks migrated: " << migrated
+                  << ", Migration time: " << migration_ns.load() / 1000.0 << "us";
+        if (migrated > 0) {
+            std::cout << " (" << static_cast<double>(migration_ns.load()) / migrated << "ns/task)";
+        }
+        std::cout << "\n";
+        
+        long long episodes = balance_episodes.load();
+        if (episodes > 0) {
+            std::cout << "Watermark episodes balanced: " << episodes
+                      << ", Avg time-to-balance: " << total_time_to_balance_ns.load() / 1000.0 / episodes << "us"
+                      << ", Max: " << max_time_to_balance_ns.load() / 1000.0 << "us\n";
+        }
+    }
+    
     void waitForCompletion() {
         // Wait until all tasks are completed
         while (active_tasks.load() > 0) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            recordImbalanceSample();
+            pause(10);
         }
     }
     
@@ -236,71 +1108,253 @@ public:
         }
         std::cout << "Active Tasks: " << active_tasks.load() << "\n";
         std::cout << "Completed Tasks: " << completed_tasks.load() << "\n";
+        if (data_bytes_read > 0) {
+            std::cout << "Task data read: " << (data_bytes_read.load() >> 20) << " MiB, "
+                      << local_data_reads.load() << " task(s) on the data's node, "
+                      << remote_data_reads.load() << " remote after a steal or migration\n";
+        }
+    }
+    
+    void displayStealStats() {
+        std::cout << "\n=== WORK STEALING STATISTICS ===\n";
+        std::cout << "Steal attempts: " << steal_attempts.load()
+                  << ", Successful: " << steal_successes.load()
+                  << ", Tasks migrated: " << stolen_tasks.load() << "\n";
+        
+        std::lock_guard<std::mutex> lock(samples_mutex);
+        if (imbalance_samples.empty()) return;
+        
+        long long total = 0;
+        int peak = 0;
+        for (const auto& sample : imbalance_samples) {
+            total += sample.imbalance;
+            peak = std::max(peak, sample.imbalance);
+        }
+        std::cout << "Load imbalance: avg " << static_cast<double>(total) / imbalance_samples.size()
+                  << ", peak " << peak << " over " << imbalance_samples.size() << " samples\n";
+        
+        // Show at most 16 evenly spaced samples
+        size_t step = std::max<size_t>(1, imbalance_samples.size() / 16);
+        std::cout << "Imbalance over time:";
+        for (size_t i = 0; i < imbalance_samples.size(); i += step) {
+            std::cout << " " << imbalance_samples[i].time_ms << "ms=" << imbalance_samples[i].imbalance;
+        }
+        std::cout << "\n";
+    }
+    
+    long long getStealAttempts() const { return steal_attempts.load(); }
+    long long getStealSuccesses() const { return steal_successes.load(); }
+    long long getStolenTasks() const { return stolen_tasks.load(); }
+    
+    double getAverageDispatchLatencyUs() const {
+        int done = completed_tasks.load();
+        return done > 0 ? total_dispatch_ns.load() / 1000.0 / done : 0.0;
+    }
+    
+    double getMaxDispatchLatencyUs() const {
+        return max_dispatch_ns.load() / 1000.0;
     }
     
     void stop() {
         running = false;
-        cv.notify_all();
+        if (virtual_time) {
+            if (submitter_finished) return;
+            clock->wakeIdle();
+            clock->finish(num_cores);
+            submitter_finished = true;
+            return;
+        }
+        idle_event.notifyAll();
+        balance_event.notifyAll();
     }
 };
 
-// NUMA-aware scheduler simulation
-class NUMAScheduler {
-private:
-    struct NUMANode {
-        int node_id;
-        std::vector<int> cpu_cores;
-        int memory_latency; // Access latency in nanoseconds
-        
-        NUMANode(int id, std::vector<int> cores, int latency) 
-            : node_id(id), cpu_cores(std::move(cores)), memory_latency(latency) {}
-    };
+// Dispatch benchmark: zero-burst tasks, half pinned to a core and half
+// spread over the cores by addTask(), so the numbers reflect queueing and stealing overhead only
+void benchmarkDispatch(int num_cores, int num_tasks) {
+    MultiProcessorScheduler scheduler(num_cores);
+    scheduler.setVerbose(false);
     
-    std::vector<NUMANode> numa_nodes;
+    std::vector<std::thread> cpu_threads;
+    for (int i = 0; i < num_cores; i++) {
+        cpu_threads.emplace_back(&MultiProcessorScheduler::cpuScheduler, &scheduler, i);
+    }
     
-public:
-    NUMAScheduler() {
-        // Simulate 2 NUMA nodes
-        numa_nodes.emplace_back(0, std::vector<int>{0, 1}, 100); // Local access
-        numa_nodes.emplace_back(1, std::vector<int>{2, 3}, 300); // Remote access
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_tasks; i++) {
+        scheduler.addTask(Task(i, 0, (i % 2 == 0) ? i % num_cores : -1));
     }
+    scheduler.waitForCompletion();
+    auto end = std::chrono::steady_clock::now();
     
-    int selectOptimalCore(int preferred_node = -1) {
-        if (preferred_node >= 0 && preferred_node < static_cast<int>(numa_nodes.size())) {
-            // Return first available core from preferred NUMA node
-            const auto& node = numa_nodes[preferred_node];
-            if (!node.cpu_cores.empty()) {
-                return node.cpu_cores[0];
-            }
+    scheduler.stop();
+    for (auto& thread : cpu_threads) {
+        thread.join();
+    }
+    
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Cores: " << num_cores
+              << ", Tasks/sec: " << static_cast<long long>(num_tasks / seconds)
+              << ", Avg dispatch latency: " << scheduler.getAverageDispatchLatencyUs() << "us"
+              << ", Max: " << scheduler.getMaxDispatchLatencyUs() << "us\n";
+}
+
+// Stealing benchmark: every task starts on Core 0, so all parallelism has
+// to come from the other cores stealing
+void benchmarkStealing(int num_cores, int num_tasks, bool locality_bias) {
+    MultiProcessorScheduler scheduler(num_cores);
+    scheduler.setVerbose(false);
+    NUMAScheduler numa(4, num_cores / 4);
+    if (locality_bias) {
+        scheduler.setLocalityBias(numa);
+    }
+    
+    std::vector<std::thread> cpu_threads;
+    for (int i = 0; i < num_cores; i++) {
+        cpu_threads.emplace_back(&MultiProcessorScheduler::cpuScheduler, &scheduler, i);
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_tasks; i++) {
+        scheduler.addTask(Task(i, 1, 0));
+    }
+    scheduler.waitForCompletion();
+    auto end = std::chrono::steady_clock::now();
+    
+    scheduler.stop();
+    for (auto& thread : cpu_threads) {
+        thread.join();
+    }
+    
+    std::cout << "\nLocality bias: " << (locality_bias ? "on" : "off")
+              << ", Makespan: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+              << "ms";
+    scheduler.displayStealStats();
+}
+
+// Read bandwidth from the first CPU of node 0 to memory bound to each node
+void benchmarkMemoryBandwidth(const HostTopology& host, size_t bytes) {
+    std::cout << "\n=== NUMA MEMORY BANDWIDTH (" << (bytes >> 20) << " MiB, reader on node "
+              << host.nodes[0].node_id << ") ===\n";
+    
+    cpu_set_t original;
+    pthread_getaffinity_np(pthread_self(), sizeof(original), &original);
+    if (host.nodes[0].cpus.empty() || !pinCurrentThread(host.nodes[0].cpus[0])) {
+        std::cout << "Could not pin benchmark thread, results are not node-specific\n";
+    }
+    
+    for (const auto& node : host.nodes) {
+        void* buffer = NUMAMemory::allocate(bytes);
+        if (!buffer) {
+            std::cout << "Node " << node.node_id << ": allocation failed\n";
+            continue;
         }
+        bool bound = NUMAMemory::bindToNode(buffer, bytes, node.node_id);
+        std::memset(buffer, 1, bytes);
         
-        // Find node with lowest memory latency that has available cores
-        int best_node = 0;
-        int min_latency = numa_nodes[0].memory_latency;
-        
-        for (size_t i = 1; i < numa_nodes.size(); i++) {
-            if (numa_nodes[i].memory_latency < min_latency) {
-                min_latency = numa_nodes[i].memory_latency;
-                best_node = static_cast<int>(i);
+        const uint64_t* words = static_cast<const uint64_t*>(buffer);
+        size_t count = bytes / sizeof(uint64_t);
+        uint64_t sum = 0;
+        double best_seconds = 1e30;
+        for (int run = 0; run < 3; run++) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < count; i++) {
+                sum += words[i];
             }
+            auto end = std::chrono::steady_clock::now();
+            best_seconds = std::min(best_seconds, std::chrono::duration<double>(end - start).count());
         }
         
-        return numa_nodes[best_node].cpu_cores[0];
+        std::cout << "Node " << node.node_id << (node.node_id == host.nodes[0].node_id ? " (local) " : " (remote)")
+                  << ": " << bytes / best_seconds / 1e9 << " GB/s"
+                  << (bound ? "" : " [mbind failed, first-touch placement]")
+                  << " (checksum " << (sum & 0xff) << ")\n";
+        NUMAMemory::release(buffer, bytes);
     }
     
-    void displayNUMATopology() {
-        std::cout << "\n=== NUMA TOPOLOGY ===\n";
-        for (const auto& node : numa_nodes) {
-            std::cout << "NUMA Node " << node.node_id 
-                      << ": CPUs [";
-            for (size_t i = 0; i < node.cpu_cores.size(); i++) {
-                std::cout << node.cpu_cores[i];
-                if (i < node.cpu_cores.size() - 1) std::cout << ", ";
-            }
-            std::cout << "], Memory Latency: " << node.memory_latency << "ns\n";
+    if (host.nodes.size() == 1) {
+        std::cout << "Single NUMA node - no remote memory to compare against\n";
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(original), &original);
+}
+
+// Burst benchmark: every burst_size tasks land on one core at once and the
+// balancer has to spread them; stealing is what the other cores do anyway
+void benchmarkBalancer(int num_cores, int bursts, int burst_size) {
+    MultiProcessorScheduler scheduler(num_cores);
+    scheduler.setVerbose(false);
+    
+    std::vector<std::thread> cpu_threads;
+    for (int i = 0; i < num_cores; i++) {
+        cpu_threads.emplace_back(&MultiProcessorScheduler::cpuScheduler, &scheduler, i);
+    }
+    std::thread balancer(&MultiProcessorScheduler::loadBalancer, &scheduler);
+    
+    for (int b = 0; b < bursts; b++) {
+        for (int i = 0; i < burst_size; i++) {
+            scheduler.addTask(Task(b * burst_size + i, 1, b % num_cores));
         }
+        scheduler.waitForCompletion();
     }
-};
+    
+    scheduler.stop();
+    balancer.join();
+    for (auto& thread : cpu_threads) {
+        thread.join();
+    }
+    
+    std::cout << "\nCores: " << num_cores << ", Bursts: " << bursts << " x " << burst_size << " tasks";
+    scheduler.displayBalancerStats();
+}
+
+// The demo's workload (bursts 50-200 ms, every third task pinned, 0-49 ms
+// apart) from a fixed seed, on the virtual or real clock. Returns the
+// virtual-time trace hash.
+uint64_t runSchedulingExperiment(bool virtual_time, int num_cores, int num_tasks, unsigned int seed) {
+    MultiProcessorScheduler scheduler(num_cores);
+    scheduler.setVerbose(false);
+    if (virtual_time) scheduler.useVirtualTime();
+    
+    std::vector<std::thread> cpu_threads;
+    for (int i = 0; i < num_cores; i++) {
+        cpu_threads.emplace_back(&MultiProcessorScheduler::cpuScheduler, &scheduler, i);
+    }
+    std::thread balancer(&MultiProcessorScheduler::loadBalancer, &scheduler);
+    scheduler.enterAsSubmitter();
+    
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> burst_dist(50, 200);
+    std::uniform_int_distribution<> affinity_dist(0, num_cores - 1);
+    std::uniform_int_distribution<> gap_dist(0, 49);
+    
+    auto start = std::chrono::steady_clock::now();
+    long long first_arrival = scheduler.nowNs();
+    for (int i = 1; i <= num_tasks; i++) {
+        int burst_time = burst_dist(gen);
+        int preferred_cpu = (i % 3 == 0) ? affinity_dist(gen) : -1;
+        scheduler.addTask(Task(i, burst_time, preferred_cpu));
+        scheduler.pause(gap_dist(gen));
+    }
+    scheduler.waitForCompletion();
+    long long makespan_ns = scheduler.nowNs() - first_arrival;
+    auto end = std::chrono::steady_clock::now();
+    
+    scheduler.stop();
+    balancer.join();
+    for (auto& thread : cpu_threads) {
+        thread.join();
+    }
+    
+    std::cout << (virtual_time ? "\nVirtual" : "\nReal") << " time, Cores: " << num_cores 
+              << ", Tasks: " << num_tasks << ", Makespan: " << makespan_ns / 1000000 << "ms"
+              << ", Wall time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << "ms"
+              << ", Avg dispatch latency: " << scheduler.getAverageDispatchLatencyUs() / 1000.0 << "ms";
+    if (virtual_time) {
+        std::cout << ", Trace hash: " << std::hex << scheduler.getTraceHash() << std::dec;
+    }
+    std::cout << "\n";
+    return scheduler.getTraceHash();
+}
 
 int main() {
     try {
@@ -308,6 +1362,12 @@ int main() {
         
         const int NUM_CORES = 4;
         MultiProcessorScheduler scheduler(NUM_CORES);
+        NUMAScheduler numa_scheduler;
+        scheduler.setLocalityBias(numa_scheduler);
+        
+        HostTopology host = HostTopology::detect();
+        host.display();
+        scheduler.pinToHostCpus(host.online_cpus);
         
         // Start CPU schedulers
         std::vector<std::thread> cpu_threads;
@@ -324,12 +1384,20 @@ int main() {
         std::uniform_int_distribution<> burst_dist(50, 200);
         std::uniform_int_distribution<> affinity_dist(0, NUM_CORES - 1);
         
+        // Core loads at the most uneven moment while tasks were queued, for
+        // the load-aware core selection below
+        std::vector<int> peak_loads(NUM_CORES, 0);
+        int peak_spread = -1;
+        
         std::cout << "Generating tasks...\n";
         for (int i = 1; i <= 12; i++) {
             int burst_time = burst_dist(gen);
             int preferred_cpu = (i % 3 == 0) ? affinity_dist(gen) : -1; // Some tasks have affinity
             
             Task task(i, burst_time, preferred_cpu);
+            if (preferred_cpu >= 0) {
+                task.data_bytes = 1 << 20; // placed on the preferred core's node by addTask()
+            }
             scheduler.addTask(task);
             
             if (preferred_cpu >= 0) {
@@ -338,6 +1406,13 @@ int main() {
                 std::cout << "Added Task " << i << " without CPU affinity\n";
             }
             
+            std::vector<int> loads = scheduler.getCoreLoads();
+            int spread = *std::max_element(loads.begin(), loads.end()) - *std::min_element(loads.begin(), loads.end());
+            if (spread > peak_spread) {
+                peak_spread = spread;
+                peak_loads = loads;
+            }
+            
             std::this_thread::sleep_for(std::chrono::milliseconds(50));
         }
         
@@ -345,13 +1420,23 @@ int main() {
         scheduler.waitForCompletion();
         
         scheduler.displayStats();
+        scheduler.displayStealStats();
+        scheduler.displayBalancerStats();
         
         // Demonstrate NUMA awareness
-        NUMAScheduler numa_scheduler;
         numa_scheduler.displayNUMATopology();
         
-        std::cout << "\nOptimal core for NUMA node 0: " << numa_scheduler.selectOptimalCore(0) << "\n";
-        std::cout << "Optimal core for NUMA node 1: " << numa_scheduler.selectOptimalCore(1) << "\n";
+        std::cout << "\nCore loads at peak imbalance:";
+        for (int i = 0; i < NUM_CORES; i++) {
+            std::cout << " Core " << i << "=" << peak_loads[i];
+        }
+        std::cout << "\nOptimal core for NUMA node 0: " << numa_scheduler.selectOptimalCore(0, peak_loads) << "\n";
+        std::cout << "Optimal core for NUMA node 1: " << numa_scheduler.selectOptimalCore(1, peak_loads) << "\n";
+        
+        NUMAScheduler host_numa(host);
+        host_numa.displayNUMATopology();
+        std::cout << "Optimal host CPU for node " << host.nodes[0].node_id << ": "
+                  << host_numa.selectOptimalCore(0) << "\n";
         
         // Stop scheduler
         scheduler.stop();
@@ -366,6 +1451,27 @@ int main() {
             }
         }
         
+        std::cout << "\n=== TASK DISPATCH BENCHMARK ===\n";
+        for (int cores : {4, 16, 64}) {
+            benchmarkDispatch(cores, 200000);
+        }
+        
+        std::cout << "\n=== WORK STEALING BENCHMARK (all tasks queued on Core 0) ===\n";
+        benchmarkStealing(16, 2000, false);
+        benchmarkStealing(16, 2000, true);
+        
+        std::cout << "\n=== EVENT-DRIVEN LOAD BALANCER BENCHMARK ===\n";
+        benchmarkBalancer(8, 5, 200);
+        
+        benchmarkMemoryBandwidth(host, 128u << 20);
+        
+        std::cout << "\n=== VIRTUAL TIME vs REAL TIME ===";
+        runSchedulingExperiment(false, NUM_CORES, 12, 7);
+        runSchedulingExperiment(true, NUM_CORES, 12, 7);
+        uint64_t first = runSchedulingExperiment(true, 16, 20000, 7);
+        uint64_t second = runSchedulingExperiment(true, 16, 20000, 7);
+        std::cout << "Same seed, identical schedules: " << (first == second ? "yes" : "NO") << "\n";
+        
         std::cout << "\nMulti-processor scheduling demo completed!\n";
         
     } catch (const std::exception& e) {
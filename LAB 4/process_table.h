@@ -0,0 +1,72 @@
+// File: process_table.h
+// Process table shared by the LAB 4 schedulers (Lap4-1, lap4-2, lap4-3)
+
+#ifndef LAB4_PROCESS_TABLE_H
+#define LAB4_PROCESS_TABLE_H
+
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+
+// Process table in structure-of-arrays layout: one contiguous column per
+// field, so a scan over arrival_time or remaining_time only pulls that
+// column through the cache. Turnaround and waiting time are derived from
+// completion_time instead of being stored (0 until the process completes).
+class ProcessTable {
+public:
+    std::vector<int32_t> pid;
+    std::vector<int32_t> arrival_time;
+    std::vector<int32_t> burst_time;
+    std::vector<int32_t> remaining_time;
+    std::vector<int32_t> completion_time;
+    std::vector<int16_t> priority;
+    
+    size_t size() const { return pid.size(); }
+    bool empty() const { return pid.empty(); }
+    
+    void reserve(size_t n) {
+        pid.reserve(n);
+        arrival_time.reserve(n);
+        burst_time.reserve(n);
+        remaining_time.reserve(n);
+        completion_time.reserve(n);
+        priority.reserve(n);
+    }
+    
+    // priority is stored as int16_t; values outside its range throw
+    // std::out_of_range instead of wrapping
+    void add(int id, int at, int bt, int pr = 0) {
+        if (pr < INT16_MIN || pr > INT16_MAX) {
+            throw std::out_of_range("ProcessTable::add: priority " + std::to_string(pr)
+                                    + " of process " + std::to_string(id) + " does not fit in int16_t");
+        }
+        pid.push_back(id);
+        arrival_time.push_back(at);
+        burst_time.push_back(bt);
+        remaining_time.push_back(bt);
+        completion_time.push_back(0);
+        priority.push_back(static_cast<int16_t>(pr));
+    }
+    
+    // Clears the results of a previous run so the table can be scheduled again
+    void resetResults() {
+        remaining_time = burst_time;
+        std::fill(completion_time.begin(), completion_time.end(), 0);
+    }
+    
+    int turnaroundTime(size_t i) const {
+        return completion_time[i] ? completion_time[i] - arrival_time[i] : 0;
+    }
+    
+    int waitingTime(size_t i) const {
+        return completion_time[i] ? turnaroundTime(i) - burst_time[i] : 0;
+    }
+    
+    size_t bytes() const {
+        return size() * (5 * sizeof(int32_t) + sizeof(int16_t));
+    }
+};
+
+#endif // LAB4_PROCESS_TABLE_H
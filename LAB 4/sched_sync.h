@@ -0,0 +1,151 @@
+// File: sched_sync.h
+// Synchronisation shared by thread_scheduling.cpp (lap4-4) and
+// multiprocessor_scheduling.cpp (lap4-5)
+
+#ifndef LAB4_SCHED_SYNC_H
+#define LAB4_SCHED_SYNC_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+
+// Eventcount for parking idle threads. A waiter announces itself with
+// prepareWait(), re-checks for work, then either cancelWait()s or wait()s.
+// The notify calls only touch the mutex when someone is actually parked.
+class EventCount {
+private:
+    std::atomic<uint64_t> epoch{0};
+    std::atomic<int> waiters{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+    
+public:
+    uint64_t prepareWait() {
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        return epoch.load(std::memory_order_seq_cst);
+    }
+    
+    void cancelWait() {
+        waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+    
+    void wait(uint64_t key) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this, key] { return epoch.load(std::memory_order_seq_cst) != key; });
+        waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+    
+    void notifyOne() {
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cv.notify_one();
+        }
+    }
+    
+    void notifyAll() {
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cv.notify_all();
+        }
+    }
+};
+
+// Discrete-event clock for virtual-time runs. Every participating thread is
+// an actor; exactly one actor runs at a time and hands over when it sleeps
+// or goes idle, and the clock then jumps to the earliest pending wakeup.
+// Ties go to whichever wakeup was scheduled first, so a run repeats exactly.
+class VirtualClock {
+private:
+    struct Event {
+        long long time_ns;
+        uint64_t seq;
+        int actor;
+        
+        bool operator>(const Event& other) const {
+            return time_ns != other.time_ns ? time_ns > other.time_ns : seq > other.seq;
+        }
+    };
+    
+    std::mutex mutex;
+    std::unique_ptr<std::condition_variable[]> turn_cv; // one per actor
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    std::vector<bool> idle;
+    std::atomic<long long> now_ns{0};
+    uint64_t next_seq = 0;
+    int running_actor = -1;
+    
+    // Caller holds mutex and gives up its turn
+    void handOff() {
+        running_actor = -1;
+        if (events.empty()) return; // everyone idle - nothing left to simulate
+        
+        Event next = events.top();
+        events.pop();
+        now_ns.store(std::max(now_ns.load(), next.time_ns));
+        running_actor = next.actor;
+        turn_cv[next.actor].notify_one();
+    }
+    
+    void waitTurn(std::unique_lock<std::mutex>& lock, int actor) {
+        turn_cv[actor].wait(lock, [this, actor] { return running_actor == actor; });
+    }
+    
+public:
+    // All actors start at time 0, in id order
+    explicit VirtualClock(int num_actors) 
+        : turn_cv(new std::condition_variable[num_actors]), idle(num_actors, false) {
+        for (int actor = 0; actor < num_actors; actor++) {
+            events.push({0, next_seq++, actor});
+        }
+        handOff();
+    }
+    
+    long long now() const { return now_ns.load(); }
+    
+    // First call of every actor thread
+    void start(int actor) {
+        std::unique_lock<std::mutex> lock(mutex);
+        waitTurn(lock, actor);
+    }
+    
+    void sleepFor(int actor, long long ns) {
+        std::unique_lock<std::mutex> lock(mutex);
+        events.push({now_ns.load() + ns, next_seq++, actor});
+        handOff();
+        waitTurn(lock, actor);
+    }
+    
+    // Blocks until another actor calls wakeIdle()
+    void waitIdle(int actor) {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle[actor] = true;
+        handOff();
+        waitTurn(lock, actor);
+    }
+    
+    void wakeIdle() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t actor = 0; actor < idle.size(); actor++) {
+            if (idle[actor]) {
+                idle[actor] = false;
+                events.push({now_ns.load(), next_seq++, static_cast<int>(actor)});
+            }
+        }
+    }
+    
+    // Last call of an actor thread
+    void finish(int actor) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running_actor == actor) handOff();
+    }
+};
+
+#endif // LAB4_SCHED_SYNC_H
@@ -6,6 +6,15 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <list>
+#include <queue>
+#include <string>
+#include <algorithm>
+#include <unordered_map>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
 
 using namespace std;
 
@@ -147,8 +156,1257 @@ public:
     }
 };
 
-int main()
+// Interface shared by the page tables for large virtual address spaces.
+// Mappings are 4 KiB pages; translate returns INVALID_ADDRESS when the
+// address is not mapped.
+class AddressTranslator
 {
+public:
+    static constexpr uint64_t INVALID_ADDRESS = ~0ULL;
+
+    virtual ~AddressTranslator() {}
+    virtual string getName() const = 0;
+    virtual bool addMapping(uint64_t va, uint64_t pa) = 0;
+    virtual bool removeMapping(uint64_t va) = 0;
+    virtual uint64_t translate(uint64_t va) = 0;
+    virtual size_t getMemoryFootprint() const = 0;
+};
+
+// Four-level radix page table for a 48-bit virtual address space, laid out
+// like x86-64: 9 index bits per level above a 12-bit page offset. Levels
+// are allocated only when a mapping needs them, and a leaf can also sit at
+// level 1 (2 MiB page) or level 2 (1 GiB page). Entries are 64-bit words:
+// a present bit, a large-page bit, and a physical address (leaf) or child
+// table number (interior). A small direct-mapped page-walk cache remembers
+// which level-0 table serves each 2 MiB region, so most walks read one
+// entry instead of four. Tables are not reclaimed when they become empty,
+// so cached table numbers never go stale.
+class RadixPageTable : public AddressTranslator
+{
+public:
+    enum PageSize { PAGE_4K = 0, PAGE_2M = 1, PAGE_1G = 2 };
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int INDEX_BITS = 9;
+    static constexpr int PAGE_SHIFT = 12;
+    static constexpr int ADDRESS_BITS = 48;
+    static constexpr uint64_t ENTRY_PRESENT = 1;
+    static constexpr uint64_t ENTRY_LARGE = 2;
+    static constexpr uint64_t ENTRY_ADDRESS = 0x000FFFFFFFFFF000ULL;
+    static constexpr int WALK_CACHE_SIZE = 64;
+    static constexpr uint64_t NO_TAG = ~0ULL;
+
+    struct Table
+    {
+        uint64_t entry[1 << INDEX_BITS];
+    };
+
+    struct WalkCacheEntry
+    {
+        uint64_t tag;       // Virtual address >> 21
+        uint32_t table;     // Level-0 table for that 2 MiB region
+    };
+
+    vector<Table> tables;   // tables[0] is the root
+    WalkCacheEntry walkCache[WALK_CACHE_SIZE];
+    long long mappings[3];
+    long long translations;
+    long long walkCacheHits;
+    long long entryReads;
+
+    static int indexAt(uint64_t va, int level)
+    {
+        return static_cast<int>((va >> (PAGE_SHIFT + INDEX_BITS * level)) & ((1 << INDEX_BITS) - 1));
+    }
+
+    static uint64_t pageBytes(int level)
+    {
+        return 1ULL << (PAGE_SHIFT + INDEX_BITS * level);
+    }
+
+    uint32_t allocateTable()
+    {
+        tables.emplace_back();
+        memset(tables.back().entry, 0, sizeof(Table));
+        return static_cast<uint32_t>(tables.size() - 1);
+    }
+
+    // Walks to the leaf entry for va. Returns the physical address, or
+    // INVALID_ADDRESS. leafTable receives the level-0 table when the walk
+    // reaches one, and largeMask the offset mask when it ends at a 2 MiB or
+    // 1 GiB page, so callers can reuse the walk for neighbouring addresses.
+    uint64_t walk(uint64_t va, uint32_t& leafTable, uint64_t& largeMask)
+    {
+        translations++;
+        if (va >> ADDRESS_BITS) return INVALID_ADDRESS;
+
+        uint64_t tag = va >> (PAGE_SHIFT + INDEX_BITS);
+        WalkCacheEntry& cached = walkCache[tag % WALK_CACHE_SIZE];
+        uint32_t table = 0;
+        if (cached.tag == tag)
+        {
+            walkCacheHits++;
+            table = cached.table;
+        }
+        else
+        {
+            for (int level = LEVELS - 1; level > 0; level--)
+            {
+                uint64_t e = tables[table].entry[indexAt(va, level)];
+                entryReads++;
+                if (!(e & ENTRY_PRESENT)) return INVALID_ADDRESS;
+                if (e & ENTRY_LARGE)
+                {
+                    largeMask = pageBytes(level) - 1;
+                    return ((e & ENTRY_ADDRESS) & ~largeMask) | (va & largeMask);
+                }
+                table = static_cast<uint32_t>((e & ENTRY_ADDRESS) >> PAGE_SHIFT);
+            }
+            cached = {tag, table};
+        }
+
+        leafTable = table;
+        uint64_t e = tables[table].entry[indexAt(va, 0)];
+        entryReads++;
+        if (!(e & ENTRY_PRESENT)) return INVALID_ADDRESS;
+        return (e & ENTRY_ADDRESS) | (va & (pageBytes(0) - 1));
+    }
+
+public:
+    RadixPageTable() : mappings{0, 0, 0}
+    {
+        allocateTable();
+        resetStatistics();
+    }
+
+    void resetStatistics()
+    {
+        for (WalkCacheEntry& cached : walkCache)
+        {
+            cached.tag = NO_TAG;
+        }
+        translations = walkCacheHits = entryReads = 0;
+    }
+
+    string getName() const override { return "Radix (4-level)"; }
+
+    bool addMapping(uint64_t va, uint64_t pa) override
+    {
+        return addMapping(va, pa, PAGE_4K);
+    }
+
+    // Maps the page of the given size at va to pa. Both must be aligned to
+    // the page size. Fails if va is outside 48 bits or overlaps an
+    // existing mapping.
+    bool addMapping(uint64_t va, uint64_t pa, PageSize size)
+    {
+        int leafLevel = size;
+        uint64_t mask = pageBytes(leafLevel) - 1;
+        if ((va >> ADDRESS_BITS) || (va & mask) || (pa & mask) || (pa & ~ENTRY_ADDRESS)) return false;
+
+        uint32_t table = 0;
+        for (int level = LEVELS - 1; level > leafLevel; level--)
+        {
+            int index = indexAt(va, level);
+            uint64_t e = tables[table].entry[index];
+            if (e & ENTRY_LARGE) return false;
+            if (!(e & ENTRY_PRESENT))
+            {
+                uint32_t child = allocateTable();
+                e = (static_cast<uint64_t>(child) << PAGE_SHIFT) | ENTRY_PRESENT;
+                tables[table].entry[index] = e;
+            }
+            table = static_cast<uint32_t>((e & ENTRY_ADDRESS) >> PAGE_SHIFT);
+        }
+
+        uint64_t& leaf = tables[table].entry[indexAt(va, leafLevel)];
+        if (leaf & ENTRY_PRESENT) return false;
+        leaf = pa | ENTRY_PRESENT | (leafLevel > 0 ? ENTRY_LARGE : 0);
+        mappings[size]++;
+        return true;
+    }
+
+    // Removes the mapping (of any size) covering va
+    bool removeMapping(uint64_t va) override
+    {
+        if (va >> ADDRESS_BITS) return false;
+        uint32_t table = 0;
+        for (int level = LEVELS - 1; level >= 0; level--)
+        {
+            uint64_t& e = tables[table].entry[indexAt(va, level)];
+            if (!(e & ENTRY_PRESENT)) return false;
+            if (level == 0 || (e & ENTRY_LARGE))
+            {
+                e = 0;
+                mappings[level]--;
+                return true;
+            }
+            table = static_cast<uint32_t>((e & ENTRY_ADDRESS) >> PAGE_SHIFT);
+        }
+        return false;
+    }
+
+    // Quiet translation; INVALID_ADDRESS if va is not mapped
+    uint64_t translate(uint64_t va) override
+    {
+        uint32_t leafTable;
+        uint64_t largeMask;
+        return walk(va, leafTable, largeMask);
+    }
+
+    // Batched translation: pas[i] receives the translation of vas[i].
+    // Consecutive addresses in the same 2 MiB region reuse the previous
+    // walk and read only their level-0 entry; consecutive addresses in the
+    // same huge page read nothing. Returns the number of addresses that
+    // were mapped.
+    size_t translate(const uint64_t* vas, uint64_t* pas, size_t count)
+    {
+        size_t mapped = 0;
+        uint64_t lastTag = NO_TAG;
+        uint32_t lastTable = 0;
+        uint64_t lastLargeBase = NO_TAG, lastLargeMask = 0, lastLargePa = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            uint64_t va = vas[i];
+            uint64_t tag = va >> (PAGE_SHIFT + INDEX_BITS);
+            uint64_t pa;
+            if (lastLargeMask != 0 && (va & ~lastLargeMask) == lastLargeBase)
+            {
+                translations++;
+                pa = lastLargePa | (va & lastLargeMask);
+            }
+            else if (tag == lastTag)
+            {
+                translations++;
+                entryReads++;
+                uint64_t e = tables[lastTable].entry[indexAt(va, 0)];
+                pa = (e & ENTRY_PRESENT) ? (e & ENTRY_ADDRESS) | (va & (pageBytes(0) - 1)) : INVALID_ADDRESS;
+            }
+            else
+            {
+                uint32_t leafTable = UINT32_MAX;
+                uint64_t largeMask = 0;
+                pa = walk(va, leafTable, largeMask);
+                lastTag = (leafTable != UINT32_MAX) ? tag : NO_TAG;
+                lastTable = leafTable;
+                if (largeMask != 0 && pa != INVALID_ADDRESS)
+                {
+                    lastLargeBase = va & ~largeMask;
+                    lastLargeMask = largeMask;
+                    lastLargePa = pa & ~largeMask;
+                }
+            }
+            pas[i] = pa;
+            mapped += (pa != INVALID_ADDRESS);
+        }
+        return mapped;
+    }
+
+    size_t getTableCount() const { return tables.size(); }
+    size_t getMemoryFootprint() const override { return tables.size() * sizeof(Table) + sizeof(walkCache); }
+    long long getMappings(PageSize size) const { return mappings[size]; }
+    long long getTranslations() const { return translations; }
+    double getWalkCacheHitRate() const { return translations ? walkCacheHits * 100.0 / translations : 0.0; }
+    double getEntryReadsPerTranslation() const { return translations ? static_cast<double>(entryReads) / translations : 0.0; }
+};
+
+// Multiplicative (Fibonacci) hash of a 64-bit key down to bits bits
+inline size_t hashKey(uint64_t key, int bits)
+{
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+}
+
+// Inverted page table: one entry per physical frame, recording which
+// virtual page it holds. A hash anchor table maps the hash of a virtual
+// page number to the first frame of its chain, and chains link through
+// the frame entries. Size follows physical memory, not the address space,
+// and any 64-bit address can be mapped.
+class InvertedPageTable : public AddressTranslator
+{
+private:
+    static constexpr int PAGE_SHIFT = 12;
+    static constexpr int32_t NO_FRAME = -1;
+
+    struct FrameEntry
+    {
+        uint64_t virtualPage;
+        int32_t next;           // Next frame on the same hash chain
+        bool used;
+    };
+
+    vector<FrameEntry> frames;
+    vector<int32_t> anchors;    // Hash anchor table
+    int hashBits;
+
+    int32_t find(uint64_t vpn) const
+    {
+        for (int32_t frame = anchors[hashKey(vpn, hashBits)]; frame != NO_FRAME; frame = frames[frame].next)
+        {
+            if (frames[frame].virtualPage == vpn) return frame;
+        }
+        return NO_FRAME;
+    }
+
+public:
+    InvertedPageTable(int numFrames) : frames(numFrames, {0, NO_FRAME, false}), hashBits(1)
+    {
+        // Anchor table with at least as many slots as frames
+        while ((1 << hashBits) < numFrames) hashBits++;
+        anchors.assign(1u << hashBits, NO_FRAME);
+    }
+
+    string getName() const override { return "Inverted"; }
+
+    bool addMapping(uint64_t va, uint64_t pa) override
+    {
+        uint64_t frame = pa >> PAGE_SHIFT;
+        uint64_t vpn = va >> PAGE_SHIFT;
+        if ((va | pa) & ((1ULL << PAGE_SHIFT) - 1)) return false;
+        if (frame >= frames.size() || frames[frame].used || find(vpn) != NO_FRAME) return false;
+
+        size_t slot = hashKey(vpn, hashBits);
+        frames[frame] = {vpn, anchors[slot], true};
+        anchors[slot] = static_cast<int32_t>(frame);
+        return true;
+    }
+
+    bool removeMapping(uint64_t va) override
+    {
+        uint64_t vpn = va >> PAGE_SHIFT;
+        for (int32_t* link = &anchors[hashKey(vpn, hashBits)]; *link != NO_FRAME; link = &frames[*link].next)
+        {
+            FrameEntry& entry = frames[*link];
+            if (entry.virtualPage == vpn)
+            {
+                *link = entry.next;
+                entry = {0, NO_FRAME, false};
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint64_t translate(uint64_t va) override
+    {
+        int32_t frame = find(va >> PAGE_SHIFT);
+        if (frame == NO_FRAME) return INVALID_ADDRESS;
+        return (static_cast<uint64_t>(frame) << PAGE_SHIFT) | (va & ((1ULL << PAGE_SHIFT) - 1));
+    }
+
+    size_t getMemoryFootprint() const override
+    {
+        return frames.size() * sizeof(FrameEntry) + anchors.size() * sizeof(int32_t);
+    }
+};
+
+// Hashed page table with clustered entries (Talluri, Hill and Khalidi):
+// each node maps a block of 16 consecutive virtual pages under one tag,
+// so pages that are sparse across the address space but clustered
+// locally share a node and a hash probe. Buckets double when the node
+// count passes the bucket count.
+class HashedPageTable : public AddressTranslator
+{
+private:
+    static constexpr int PAGE_SHIFT = 12;
+    static constexpr int CLUSTER_BITS = 4;
+    static constexpr int CLUSTER_PAGES = 1 << CLUSTER_BITS;
+    static constexpr int32_t NO_NODE = -1;
+
+    struct Node
+    {
+        uint64_t tag;                       // Virtual page number >> CLUSTER_BITS
+        uint32_t frame[CLUSTER_PAGES];
+        uint16_t validMask;
+        int32_t next;
+    };
+
+    vector<Node> nodes;
+    vector<int32_t> freeNodes;
+    vector<int32_t> buckets;
+    int bucketBits;
+    size_t liveNodes;
+
+    int32_t findNode(uint64_t tag) const
+    {
+        for (int32_t node = buckets[hashKey(tag, bucketBits)]; node != NO_NODE; node = nodes[node].next)
+        {
+            if (nodes[node].tag == tag) return node;
+        }
+        return NO_NODE;
+    }
+
+    void grow()
+    {
+        bucketBits++;
+        buckets.assign(1u << bucketBits, NO_NODE);
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            if (nodes[i].validMask == 0) continue;
+            int32_t& head = buckets[hashKey(nodes[i].tag, bucketBits)];
+            nodes[i].next = head;
+            head = static_cast<int32_t>(i);
+        }
+    }
+
+public:
+    HashedPageTable() : bucketBits(10), liveNodes(0)
+    {
+        buckets.assign(1u << bucketBits, NO_NODE);
+    }
+
+    string getName() const override { return "Hashed (clustered)"; }
+
+    bool addMapping(uint64_t va, uint64_t pa) override
+    {
+        uint64_t vpn = va >> PAGE_SHIFT;
+        uint64_t frame = pa >> PAGE_SHIFT;
+        if (((va | pa) & ((1ULL << PAGE_SHIFT) - 1)) || frame > UINT32_MAX) return false;
+
+        uint64_t tag = vpn >> CLUSTER_BITS;
+        int slot = static_cast<int>(vpn & (CLUSTER_PAGES - 1));
+        int32_t node = findNode(tag);
+        if (node == NO_NODE)
+        {
+            if (liveNodes + 1 > buckets.size()) grow();
+            if (!freeNodes.empty())
+            {
+                node = freeNodes.back();
+                freeNodes.pop_back();
+            }
+            else
+            {
+                nodes.emplace_back();
+                node = static_cast<int32_t>(nodes.size() - 1);
+            }
+            int32_t& head = buckets[hashKey(tag, bucketBits)];
+            nodes[node].tag = tag;
+            nodes[node].validMask = 0;
+            nodes[node].next = head;
+            head = node;
+            liveNodes++;
+        }
+
+        Node& entry = nodes[node];
+        if (entry.validMask & (1u << slot)) return false;
+        entry.frame[slot] = static_cast<uint32_t>(frame);
+        entry.validMask |= static_cast<uint16_t>(1u << slot);
+        return true;
+    }
+
+    bool removeMapping(uint64_t va) override
+    {
+        uint64_t vpn = va >> PAGE_SHIFT;
+        uint64_t tag = vpn >> CLUSTER_BITS;
+        int slot = static_cast<int>(vpn & (CLUSTER_PAGES - 1));
+        for (int32_t* link = &buckets[hashKey(tag, bucketBits)]; *link != NO_NODE; link = &nodes[*link].next)
+        {
+            Node& entry = nodes[*link];
+            if (entry.tag != tag) continue;
+            if (!(entry.validMask & (1u << slot))) return false;
+            entry.validMask &= static_cast<uint16_t>(~(1u << slot));
+            if (entry.validMask == 0)
+            {
+                // Last page of the cluster: unlink and recycle the node
+                int32_t node = *link;
+                *link = entry.next;
+                freeNodes.push_back(node);
+                liveNodes--;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    uint64_t translate(uint64_t va) override
+    {
+        uint64_t vpn = va >> PAGE_SHIFT;
+        int32_t node = findNode(vpn >> CLUSTER_BITS);
+        int slot = static_cast<int>(vpn & (CLUSTER_PAGES - 1));
+        if (node == NO_NODE || !(nodes[node].validMask & (1u << slot))) return INVALID_ADDRESS;
+        return (static_cast<uint64_t>(nodes[node].frame[slot]) << PAGE_SHIFT) | (va & ((1ULL << PAGE_SHIFT) - 1));
+    }
+
+    size_t getMemoryFootprint() const override
+    {
+        return nodes.size() * sizeof(Node) + buckets.size() * sizeof(int32_t) + freeNodes.size() * sizeof(int32_t);
+    }
+};
+
+// Replacement policy interface shared by every algorithm below. For each
+// reference the pager first sets the entry's referenced (and, on writes,
+// dirty) bit, then calls recordAccess on a hit, or chooseVictim (only
+// when all frames are in use) followed by recordLoad on a fault. Policies
+// may read and clear the entries' bits.
+class ReplacementPolicy
+{
+public:
+    virtual ~ReplacementPolicy() {}
+    virtual string getName() const = 0;
+    virtual void recordAccess(int page, vector<PageTableEntry>& entries) = 0;
+    virtual void recordLoad(int page, vector<PageTableEntry>& entries) = 0;
+    virtual int chooseVictim(int incomingPage, vector<PageTableEntry>& entries) = 0;
+};
+
+// First-In-First-Out: evict the page loaded longest ago
+class FIFOPolicy : public ReplacementPolicy
+{
+private:
+    queue<int> loadOrder;
+
+public:
+    string getName() const override { return "FIFO"; }
+    void recordAccess(int, vector<PageTableEntry>&) override {}
+    void recordLoad(int page, vector<PageTableEntry>&) override { loadOrder.push(page); }
+
+    int chooseVictim(int, vector<PageTableEntry>&) override
+    {
+        int victim = loadOrder.front();
+        loadOrder.pop();
+        return victim;
+    }
+};
+
+// Least Recently Used: exact recency list, most recent at the front
+class LRUPolicy : public ReplacementPolicy
+{
+private:
+    list<int> recency;
+    vector<list<int>::iterator> position; // Indexed by page
+
+public:
+    LRUPolicy(int numPages) : position(numPages) {}
+
+    string getName() const override { return "LRU"; }
+
+    void recordAccess(int page, vector<PageTableEntry>&) override
+    {
+        recency.splice(recency.begin(), recency, position[page]);
+    }
+
+    void recordLoad(int page, vector<PageTableEntry>&) override
+    {
+        recency.push_front(page);
+        position[page] = recency.begin();
+    }
+
+    int chooseVictim(int, vector<PageTableEntry>&) override
+    {
+        int victim = recency.back();
+        recency.pop_back();
+        return victim;
+    }
+};
+
+// Belady's optimal: evict the resident page whose next use is farthest
+// away. Needs the whole reference string up front; resident pages sit in
+// a max-heap keyed by next use, and entries left behind by later
+// references are skipped because their next use is already in the past.
+class OPTPolicy : public ReplacementPolicy
+{
+private:
+    vector<int> nextUse;              // Per reference position, INT_MAX = never
+    vector<pair<int, int>> victims;   // (next use, page) heap
+    int position;                     // Index of the current reference
+    int numFrames;
+
+    void push(int page)
+    {
+        if (victims.size() > 2 * static_cast<size_t>(numFrames) + 64)
+        {
+            int now = position;
+            victims.erase(remove_if(victims.begin(), victims.end(),
+                                    [now](const pair<int, int>& v) { return v.first <= now; }),
+                          victims.end());
+            make_heap(victims.begin(), victims.end());
+        }
+        victims.push_back({nextUse[position], page});
+        push_heap(victims.begin(), victims.end());
+        position++;
+    }
+
+public:
+    OPTPolicy(const vector<int>& refString, int frames) : nextUse(refString.size()), position(0), numFrames(frames)
+    {
+        unordered_map<int, int> upcoming;
+        for (int i = static_cast<int>(refString.size()) - 1; i >= 0; i--)
+        {
+            auto it = upcoming.find(refString[i]);
+            nextUse[i] = (it == upcoming.end()) ? INT_MAX : it->second;
+            upcoming[refString[i]] = i;
+        }
+    }
+
+    string getName() const override { return "OPT"; }
+    void recordAccess(int page, vector<PageTableEntry>&) override { push(page); }
+    void recordLoad(int page, vector<PageTableEntry>&) override { push(page); }
+
+    int chooseVictim(int, vector<PageTableEntry>&) override
+    {
+        while (true)
+        {
+            pop_heap(victims.begin(), victims.end());
+            pair<int, int> top = victims.back();
+            victims.pop_back();
+            if (top.first > position) return top.second;
+        }
+    }
+};
+
+// CLOCK (second chance): frames form a ring; the hand clears referenced
+// bits as it sweeps and evicts the first page whose bit is already clear
+class ClockPolicy : public ReplacementPolicy
+{
+protected:
+    vector<int> ring;   // Page in each ring slot
+    size_t hand;
+    int victimSlot;     // Slot freed by the last chooseVictim, -1 if none
+
+public:
+    ClockPolicy() : hand(0), victimSlot(-1) {}
+
+    string getName() const override { return "CLOCK"; }
+    void recordAccess(int, vector<PageTableEntry>&) override {}
+
+    void recordLoad(int page, vector<PageTableEntry>&) override
+    {
+        if (victimSlot >= 0)
+        {
+            ring[victimSlot] = page;
+            hand = (victimSlot + 1) % ring.size();
+            victimSlot = -1;
+        }
+        else
+        {
+            ring.push_back(page);
+        }
+    }
+
+    int chooseVictim(int, vector<PageTableEntry>& entries) override
+    {
+        while (entries[ring[hand]].isReferenced())
+        {
+            entries[ring[hand]].setReferenced(false);
+            hand = (hand + 1) % ring.size();
+        }
+        victimSlot = static_cast<int>(hand);
+        return ring[hand];
+    }
+};
+
+// Enhanced second chance: ranks pages by (referenced, dirty) and evicts
+// from the lowest class found, preferring clean pages so fewer evictions
+// need a write-back. Sweep 1 looks for (0,0) without touching bits; sweep
+// 2 looks for (0,1) and clears referenced bits on the way; repeat.
+class EnhancedSecondChancePolicy : public ClockPolicy
+{
+public:
+    string getName() const override { return "Enhanced 2nd chance"; }
+
+    int chooseVictim(int, vector<PageTableEntry>& entries) override
+    {
+        size_t n = ring.size();
+        while (true)
+        {
+            for (size_t i = 0; i < n; i++, hand = (hand + 1) % n)
+            {
+                const PageTableEntry& entry = entries[ring[hand]];
+                if (!entry.isReferenced() && !entry.isDirty())
+                {
+                    victimSlot = static_cast<int>(hand);
+                    return ring[hand];
+                }
+            }
+            for (size_t i = 0; i < n; i++, hand = (hand + 1) % n)
+            {
+                PageTableEntry& entry = entries[ring[hand]];
+                if (!entry.isReferenced() && entry.isDirty())
+                {
+                    victimSlot = static_cast<int>(hand);
+                    return ring[hand];
+                }
+                entry.setReferenced(false);
+            }
+        }
+    }
+};
+
+// Adaptive Replacement Cache (Megiddo & Modha). T1 holds pages seen once
+// recently, T2 pages seen at least twice; B1/B2 remember pages recently
+// evicted from each. A fault on a B1 ghost grows T1's target size p, a
+// fault on a B2 ghost shrinks it, so the split between recency and
+// frequency adapts to the trace. Every hit is reported by the pager, so
+// ARC keeps exact lists rather than sampling referenced bits.
+class ARCPolicy : public ReplacementPolicy
+{
+private:
+    enum Where { NONE, T1, T2, B1, B2 };
+
+    int capacity;
+    int target;                         // p: desired size of T1
+    list<int> lists[5];                 // Indexed by Where, MRU at the front
+    vector<Where> where;                // Indexed by page
+    vector<list<int>::iterator> position;
+
+    int size(Where w) const { return static_cast<int>(lists[w].size()); }
+
+    void moveTo(int page, Where w)
+    {
+        if (where[page] != NONE) lists[where[page]].erase(position[page]);
+        where[page] = w;
+        if (w != NONE)
+        {
+            lists[w].push_front(page);
+            position[page] = lists[w].begin();
+        }
+    }
+
+    int lruOf(Where w) const { return lists[w].back(); }
+
+    // Evicts the LRU page of T1 or T2 into its ghost list
+    int replace(int incomingPage)
+    {
+        if (size(T1) > 0 && (size(T1) > target || (where[incomingPage] == B2 && size(T1) == target)))
+        {
+            int victim = lruOf(T1);
+            moveTo(victim, B1);
+            return victim;
+        }
+        int victim = lruOf(T2);
+        moveTo(victim, B2);
+        return victim;
+    }
+
+public:
+    ARCPolicy(int numPages, int frames) : capacity(frames), target(0), where(numPages, NONE), position(numPages) {}
+
+    string getName() const override { return "ARC"; }
+
+    void recordAccess(int page, vector<PageTableEntry>&) override { moveTo(page, T2); }
+
+    void recordLoad(int page, vector<PageTableEntry>&) override
+    {
+        moveTo(page, (where[page] == B1 || where[page] == B2) ? T2 : T1);
+    }
+
+    int chooseVictim(int incomingPage, vector<PageTableEntry>&) override
+    {
+        if (where[incomingPage] == B1)
+        {
+            target = min(capacity, target + max(size(B2) / size(B1), 1));
+            return replace(incomingPage);
+        }
+        if (where[incomingPage] == B2)
+        {
+            target = max(0, target - max(size(B1) / size(B2), 1));
+            return replace(incomingPage);
+        }
+
+        if (size(T1) + size(B1) == capacity)
+        {
+            if (size(T1) < capacity)
+            {
+                moveTo(lruOf(B1), NONE);
+                return replace(incomingPage);
+            }
+            int victim = lruOf(T1);
+            moveTo(victim, NONE);
+            return victim;
+        }
+        if (size(T1) + size(T2) + size(B1) + size(B2) == 2 * capacity)
+        {
+            moveTo(lruOf(B2), NONE);
+        }
+        return replace(incomingPage);
+    }
+};
+
+// Low Inter-reference Recency Set (Jiang & Zhang). Pages whose last two
+// references were close together are LIR and stay resident; a small share
+// of frames holds HIR pages in a FIFO queue, and only those are evicted.
+// Stack S orders pages by recency and keeps non-resident HIR entries so a
+// quick re-reference can promote a page to LIR. Like ARC, LIRS is driven
+// by the pager's hit reports.
+class LIRSPolicy : public ReplacementPolicy
+{
+private:
+    enum State { UNKNOWN, LIR, HIR_RESIDENT, HIR_NONRESIDENT };
+
+    int lirCapacity;
+    int lirCount;
+    int nonresidentCount;
+    list<int> stack;                    // S, most recent at the front
+    list<int> hirQueue;                 // Q, resident HIR pages, next victim at the front
+    vector<State> state;
+    vector<bool> inStack;
+    vector<list<int>::iterator> stackPosition;
+    vector<list<int>::iterator> queuePosition;
+
+    void pushStack(int page)
+    {
+        if (inStack[page]) stack.erase(stackPosition[page]);
+        stack.push_front(page);
+        stackPosition[page] = stack.begin();
+        inStack[page] = true;
+    }
+
+    void removeFromStack(int page)
+    {
+        stack.erase(stackPosition[page]);
+        inStack[page] = false;
+    }
+
+    void pushQueue(int page)
+    {
+        hirQueue.push_back(page);
+        queuePosition[page] = prev(hirQueue.end());
+    }
+
+    // Drops HIR entries from the bottom of S until a LIR page is there
+    void prune()
+    {
+        while (!stack.empty() && state[stack.back()] != LIR)
+        {
+            int page = stack.back();
+            if (state[page] == HIR_NONRESIDENT)
+            {
+                state[page] = UNKNOWN;
+                nonresidentCount--;
+            }
+            removeFromStack(page);
+        }
+    }
+
+    // The bottom LIR page becomes a resident HIR page
+    void demoteBottomLIR()
+    {
+        int page = stack.back();
+        state[page] = HIR_RESIDENT;
+        lirCount--;
+        removeFromStack(page);
+        pushQueue(page);
+        prune();
+    }
+
+    // Non-resident entries only matter while recent; cap them at 2x frames
+    void trimNonresident()
+    {
+        if (nonresidentCount <= 2 * lirCapacity) return;
+        for (auto it = prev(stack.end()); nonresidentCount > lirCapacity && it != stack.begin();)
+        {
+            auto current = it--;
+            if (state[*current] == HIR_NONRESIDENT)
+            {
+                state[*current] = UNKNOWN;
+                inStack[*current] = false;
+                stack.erase(current);
+                nonresidentCount--;
+            }
+        }
+    }
+
+public:
+    LIRSPolicy(int numPages, int frames)
+        : lirCapacity(max(1, frames - max(1, frames / 100))), lirCount(0), nonresidentCount(0),
+          state(numPages, UNKNOWN), inStack(numPages, false), stackPosition(numPages), queuePosition(numPages) {}
+
+    string getName() const override { return "LIRS"; }
+
+    void recordAccess(int page, vector<PageTableEntry>&) override
+    {
+        if (state[page] == LIR)
+        {
+            bool wasBottom = (page == stack.back());
+            pushStack(page);
+            if (wasBottom) prune();
+            return;
+        }
+
+        // Resident HIR page
+        hirQueue.erase(queuePosition[page]);
+        if (inStack[page])
+        {
+            state[page] = LIR;
+            lirCount++;
+            pushStack(page);
+            demoteBottomLIR();
+        }
+        else
+        {
+            pushStack(page);
+            pushQueue(page);
+        }
+    }
+
+    void recordLoad(int page, vector<PageTableEntry>&) override
+    {
+        if (lirCount < lirCapacity)
+        {
+            // Warm-up: the first pages fill the LIR set
+            state[page] = LIR;
+            lirCount++;
+            pushStack(page);
+            return;
+        }
+
+        if (state[page] == HIR_NONRESIDENT && inStack[page])
+        {
+            nonresidentCount--;
+            state[page] = LIR;
+            lirCount++;
+            pushStack(page);
+            demoteBottomLIR();
+        }
+        else
+        {
+            state[page] = HIR_RESIDENT;
+            pushStack(page);
+            pushQueue(page);
+        }
+        trimNonresident();
+    }
+
+    int chooseVictim(int, vector<PageTableEntry>&) override
+    {
+        // With a single frame no frame is left for HIR pages; evict the LIR page
+        if (hirQueue.empty()) demoteBottomLIR();
+
+        int victim = hirQueue.front();
+        hirQueue.pop_front();
+        if (inStack[victim])
+        {
+            state[victim] = HIR_NONRESIDENT;
+            nonresidentCount++;
+        }
+        else
+        {
+            state[victim] = UNKNOWN;
+        }
+        return victim;
+    }
+};
+
+// Demand pager: loads pages into a fixed number of frames on fault and
+// asks a ReplacementPolicy for victims. Quiet; only counts events.
+class DemandPager
+{
+private:
+    vector<PageTableEntry> entries;
+    vector<int> freeFrames;
+    ReplacementPolicy& policy;
+    long long hits;
+    long long faults;
+    long long evictions;
+    long long writeBacks;   // Dirty pages written back on eviction
+
+public:
+    DemandPager(int numPages, int numFrames, ReplacementPolicy& p)
+        : entries(numPages), policy(p), hits(0), faults(0), evictions(0), writeBacks(0)
+    {
+        for (int frame = numFrames - 1; frame >= 0; frame--)
+        {
+            freeFrames.push_back(frame);
+        }
+    }
+
+    void access(int page, bool write)
+    {
+        PageTableEntry& entry = entries[page];
+        if (entry.isValid())
+        {
+            hits++;
+            entry.setReferenced(true);
+            if (write) entry.setDirty(true);
+            policy.recordAccess(page, entries);
+            return;
+        }
+
+        faults++;
+        int frame;
+        if (!freeFrames.empty())
+        {
+            frame = freeFrames.back();
+            freeFrames.pop_back();
+        }
+        else
+        {
+            int victim = policy.chooseVictim(page, entries);
+            PageTableEntry& evicted = entries[victim];
+            evictions++;
+            if (evicted.isDirty()) writeBacks++;
+            frame = evicted.getFrameNumber();
+            evicted = PageTableEntry();
+        }
+
+        entry.setFrameNumber(frame);
+        entry.setValid(true);
+        entry.setReferenced(true);
+        entry.setDirty(write);
+        policy.recordLoad(page, entries);
+    }
+
+    long long getHits() const { return hits; }
+    long long getFaults() const { return faults; }
+    long long getEvictions() const { return evictions; }
+    long long getWriteBacks() const { return writeBacks; }
+};
+
+// Reference with a read/write flag
+struct PageReference
+{
+    int page;
+    bool write;
+};
+
+// Looping trace: sweeps over loopPages pages again and again. With fewer
+// frames than loopPages, LRU and FIFO evict every page just before it is
+// needed again.
+vector<PageReference> makeLoopingTrace(int length, int loopPages)
+{
+    vector<PageReference> trace(length);
+    for (int i = 0; i < length; i++)
+    {
+        trace[i] = {i % loopPages, (i % 7) == 0};
+    }
+    return trace;
+}
+
+// Scan-heavy trace: random references to a small hot set, interrupted by
+// long sequential scans over pages that are touched once
+vector<PageReference> makeScanTrace(int length, int hotPages, int scanLength, int numPages)
+{
+    vector<PageReference> trace;
+    trace.reserve(length);
+    unsigned int seed = 12345;
+    int scanPage = hotPages;
+    while (static_cast<int>(trace.size()) < length)
+    {
+        for (int i = 0; i < 4 * scanLength && static_cast<int>(trace.size()) < length; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            trace.push_back({static_cast<int>((seed >> 8) % hotPages), ((seed >> 4) % 4) == 0});
+        }
+        for (int i = 0; i < scanLength && static_cast<int>(trace.size()) < length; i++)
+        {
+            trace.push_back({scanPage, false});
+            scanPage = (scanPage + 1 < numPages) ? scanPage + 1 : hotPages;
+        }
+    }
+    return trace;
+}
+
+void comparePolicies(const string& title, const vector<PageReference>& trace, int numPages, int numFrames)
+{
+    vector<int> pages(trace.size());
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        pages[i] = trace[i].page;
+    }
+
+    FIFOPolicy fifo;
+    LRUPolicy lru(numPages);
+    OPTPolicy opt(pages, numFrames);
+    ClockPolicy clock;
+    EnhancedSecondChancePolicy secondChance;
+    ARCPolicy arc(numPages, numFrames);
+    LIRSPolicy lirs(numPages, numFrames);
+    ReplacementPolicy* policies[] = {&fifo, &lru, &opt, &clock, &secondChance, &arc, &lirs};
+
+    cout << "\n=== " << title << " (" << trace.size() << " references, " << numFrames << " frames) ===" << endl;
+    cout << left << setw(22) << "Policy" << setw(12) << "Faults" << setw(12) << "Hit Ratio"
+         << setw(12) << "Write-backs" << endl;
+    cout << string(58, '-') << endl;
+
+    for (ReplacementPolicy* policy : policies)
+    {
+        DemandPager pager(numPages, numFrames, *policy);
+        for (const PageReference& ref : trace)
+        {
+            pager.access(ref.page, ref.write);
+        }
+        cout << left << setw(22) << policy->getName() << setw(12) << pager.getFaults()
+             << setw(12) << (to_string(pager.getHits() * 100 / static_cast<long long>(trace.size())) + "%")
+             << setw(12) << pager.getWriteBacks() << endl;
+    }
+    cout << right;
+}
+
+// Footprint and translation rate of the radix table for dense, sparse and
+// huge-page layouts of the same amount of memory
+void benchmarkRadixPageTable(int numPages, size_t numLookups)
+{
+    cout << "\n=== Radix Page Table: " << numPages << " x 4 KiB of mapped memory, "
+         << numLookups << " lookups ===" << endl;
+    cout << "A flat table for 48-bit addresses would need " << ((1ULL << 36) * 8 >> 30) << " GiB" << endl;
+    cout << left << setw(12) << "Layout" << setw(10) << "Tables" << setw(14) << "Footprint"
+         << setw(14) << "Random M/s" << setw(14) << "Batched M/s" << setw(16) << "Sequential M/s"
+         << setw(12) << "Walk Cache" << "Reads/Xlate" << endl;
+    cout << string(104, '-') << endl;
+
+    const uint64_t base = 0x7f0000000000ULL;
+    const size_t blockSize = 4096;
+    enum Layout { DENSE, SPARSE, HUGE_2M, HUGE_1G };
+    const char* names[] = {"Dense 4K", "Sparse 4K", "Dense 2M", "Dense 1G"};
+
+    for (int layout = DENSE; layout <= HUGE_1G; layout++)
+    {
+        RadixPageTable table;
+        vector<uint64_t> pageAddresses(numPages);
+        unsigned long long seed = 88172645463325252ULL;
+        for (int i = 0; i < numPages; i++)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            // Sparse: every page in its own random spot of the 47-bit user half
+            pageAddresses[i] = (layout == SPARSE) ? ((seed >> 17) << 12) & ((1ULL << 47) - 1)
+                                                  : base + (static_cast<uint64_t>(i) << 12);
+        }
+
+        if (layout == DENSE || layout == SPARSE)
+        {
+            for (int i = 0; i < numPages; i++)
+            {
+                table.addMapping(pageAddresses[i], static_cast<uint64_t>(i) << 12);
+            }
+        }
+        else
+        {
+            RadixPageTable::PageSize size = (layout == HUGE_2M) ? RadixPageTable::PAGE_2M : RadixPageTable::PAGE_1G;
+            uint64_t bytes = (layout == HUGE_2M) ? (1ULL << 21) : (1ULL << 30);
+            uint64_t total = static_cast<uint64_t>(numPages) << 12;
+            for (uint64_t offset = 0; offset < total; offset += bytes)
+            {
+                table.addMapping(base + offset, offset, size);
+            }
+        }
+
+        // Random lookups anywhere in the mapped pages, then a sequential sweep
+        vector<uint64_t> randomVas(numLookups), sequentialVas(numLookups), pas(numLookups);
+        for (size_t i = 0; i < numLookups; i++)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            randomVas[i] = pageAddresses[seed % numPages] + (seed >> 52);
+            sequentialVas[i] = pageAddresses[(i / 8) % numPages] + (i % 8) * 512;
+        }
+
+        table.resetStatistics();
+        auto start = chrono::steady_clock::now();
+        uint64_t checksum = 0;
+        for (size_t i = 0; i < numLookups; i++)
+        {
+            checksum += table.translate(randomVas[i]);
+        }
+        double scalarSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        double hitRate = table.getWalkCacheHitRate();
+        double reads = table.getEntryReadsPerTranslation();
+
+        start = chrono::steady_clock::now();
+        size_t mapped = 0;
+        for (size_t i = 0; i < numLookups; i += blockSize)
+        {
+            mapped += table.translate(&randomVas[i], &pas[i], min(blockSize, numLookups - i));
+        }
+        double batchSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < numLookups; i += blockSize)
+        {
+            mapped += table.translate(&sequentialVas[i], &pas[i], min(blockSize, numLookups - i));
+        }
+        double sequentialSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        string footprint = to_string(table.getMemoryFootprint() / 1024) + " KiB";
+        cout << left << setw(12) << names[layout] << setw(10) << table.getTableCount() << setw(14) << footprint
+             << fixed << setprecision(1)
+             << setw(14) << numLookups / scalarSeconds / 1e6
+             << setw(14) << numLookups / batchSeconds / 1e6
+             << setw(16) << numLookups / sequentialSeconds / 1e6
+             << setw(12) << (to_string(static_cast<int>(hitRate)) + "%")
+             << setprecision(2) << reads << endl;
+        if (mapped != 2 * numLookups || checksum == 0)
+        {
+            cout << "  unexpected unmapped lookups" << endl;
+        }
+    }
+}
+
+// Radix, inverted and hashed tables on sparse layouts in the 47-bit user
+// half: pages scattered one by one, and 64 KiB clusters scattered
+void benchmarkSparsePageTables(int numPages, size_t numLookups)
+{
+    cout << "\n=== Sparse Address Spaces: " << numPages << " pages, " << numLookups << " lookups ===" << endl;
+    cout << left << setw(16) << "Layout" << setw(22) << "Table" << setw(16) << "Footprint"
+         << setw(16) << "Bytes/Page" << "ns/Lookup" << endl;
+    cout << string(78, '-') << endl;
+
+    const char* layouts[] = {"Scattered", "64K clusters"};
+    for (int layout = 0; layout < 2; layout++)
+    {
+        vector<uint64_t> pages(numPages);
+        unsigned long long seed = 88172645463325252ULL;
+        uint64_t clusterBase = 0;
+        for (int i = 0; i < numPages; i++)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            uint64_t randomPage = ((seed >> 17) << 12) & ((1ULL << 47) - 1);
+            if (layout == 0)
+            {
+                pages[i] = randomPage;
+            }
+            else
+            {
+                if (i % 16 == 0) clusterBase = randomPage & ~0xFFFFULL;
+                pages[i] = clusterBase + (static_cast<uint64_t>(i % 16) << 12);
+            }
+        }
+
+        vector<uint64_t> lookups(numLookups);
+        for (size_t i = 0; i < numLookups; i++)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            lookups[i] = pages[seed % numPages] + (seed >> 52);
+        }
+
+        RadixPageTable radix;
+        InvertedPageTable inverted(numPages);
+        HashedPageTable hashed;
+        AddressTranslator* tables[] = {&radix, &inverted, &hashed};
+        for (AddressTranslator* table : tables)
+        {
+            for (int i = 0; i < numPages; i++)
+            {
+                table->addMapping(pages[i], static_cast<uint64_t>(i) << 12);
+            }
+
+            auto start = chrono::steady_clock::now();
+            uint64_t checksum = 0;
+            for (uint64_t va : lookups)
+            {
+                checksum += table->translate(va);
+            }
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            string footprint = to_string(table->getMemoryFootprint() / 1024) + " KiB";
+            cout << left << setw(16) << layouts[layout] << setw(22) << table->getName() << setw(16) << footprint
+                 << fixed << setprecision(1) << setw(16) << static_cast<double>(table->getMemoryFootprint()) / numPages
+                 << setprecision(1) << seconds * 1e9 / numLookups
+                 << (checksum == 0 ? " (no lookups mapped)" : "") << endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // The page-table benchmarks need about 1 GB of RAM; run them on request
+    bool runBenchmarks = argc > 1 && string(argv[1]) == "--benchmark";
+
     cout << "=== Page Table Simulator ===" << endl;
 
     // Create a page table with 16 pages, each 512 bytes
@@ -191,5 +1449,96 @@ int main()
     // Final page table state
     pt.display();
 
+    // Replacement policies on traces where LRU degrades
+    const int numPages = 100000;
+    const int numFrames = 1000;
+    comparePolicies("Looping Trace", makeLoopingTrace(1000000, 1200), numPages, numFrames);
+    comparePolicies("Scan-Heavy Trace", makeScanTrace(1000000, 500, 2000, numPages), numPages, numFrames);
+
+    // 4-level page table with huge pages
+    cout << "\n=== 48-bit Radix Page Table ===" << endl;
+    RadixPageTable radix;
+    radix.addMapping(0x00007f0000001000ULL, 0x5000);
+    radix.addMapping(0x00007f0000200000ULL, 0x40000000ULL, RadixPageTable::PAGE_2M);
+    radix.addMapping(0x0000400000000000ULL, 0x80000000ULL, RadixPageTable::PAGE_1G);
+    bool overlapRejected = !radix.addMapping(0x00007f0000201000ULL, 0x6000);
+    uint64_t probes[] = {0x00007f0000001234ULL, 0x00007f00002abcdeULL, 0x0000400012345678ULL,
+                         0x00007f0000002000ULL, 0x0001000000000000ULL};
+    for (uint64_t va : probes)
+    {
+        uint64_t pa = radix.translate(va);
+        cout << "VA 0x" << hex << va << " -> ";
+        if (pa == RadixPageTable::INVALID_ADDRESS) cout << "not mapped";
+        else cout << "PA 0x" << pa;
+        cout << dec << endl;
+    }
+    cout << "4 KiB mapping inside a 2 MiB page " << (overlapRejected ? "rejected" : "ACCEPTED") << endl;
+    radix.removeMapping(0x00007f00002abcdeULL);
+    cout << "After unmapping the 2 MiB page: " 
+         << (radix.translate(0x00007f00002abcdeULL) == RadixPageTable::INVALID_ADDRESS ? "not mapped" : "STILL MAPPED")
+         << endl;
+    cout << radix.getTableCount() << " tables, " << radix.getMemoryFootprint() << " bytes" << endl;
+
+    // Radix, inverted and hashed tables must agree on random map/unmap traffic
+    RadixPageTable checkRadix;
+    InvertedPageTable checkInverted(4096);
+    HashedPageTable checkHashed;
+    AddressTranslator* checkTables[] = {&checkRadix, &checkInverted, &checkHashed};
+    unordered_map<uint64_t, uint64_t> expected;
+    vector<bool> frameUsed(4096, false);
+    bool tablesAgree = true;
+    unsigned int state = 2463534242u;
+    for (int op = 0; op < 200000; op++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        uint64_t va = (static_cast<uint64_t>(state % 6000) << 12) + (state % 7 == 0 ? 0x7f0000000000ULL : 0);
+        uint64_t frame = (state >> 12) % 4096;
+        bool mapped = expected.count(va) > 0;
+        // Only the inverted table forbids two pages sharing a frame, so adds use free frames
+        bool add = (state >> 30) != 0 && !frameUsed[frame];
+        for (AddressTranslator* table : checkTables)
+        {
+            if (add)
+            {
+                bool ok = table->addMapping(va, frame << 12);
+                tablesAgree = tablesAgree && ok == !mapped;
+            }
+            else
+            {
+                tablesAgree = tablesAgree && table->removeMapping(va) == mapped;
+            }
+        }
+        if (add && !mapped)
+        {
+            expected[va] = frame << 12;
+            frameUsed[frame] = true;
+        }
+        else if (!add && mapped)
+        {
+            frameUsed[expected[va] >> 12] = false;
+            expected.erase(va);
+        }
+        uint64_t probe = va + (state & 0xFFF);
+        uint64_t want = expected.count(va) ? expected[va] + (state & 0xFFF) : AddressTranslator::INVALID_ADDRESS;
+        for (AddressTranslator* table : checkTables)
+        {
+            tablesAgree = tablesAgree && table->translate(probe) == want;
+        }
+    }
+    cout << "Radix, inverted and hashed tables " << (tablesAgree ? "agree" : "DISAGREE")
+         << " over 200000 random map/unmap/translate operations" << endl;
+
+    if (runBenchmarks)
+    {
+        benchmarkRadixPageTable(65536, 1 << 24);
+        benchmarkSparsePageTables(65536, 1 << 22);
+    }
+    else
+    {
+        cout << "\nRun with --benchmark for the radix and sparse page table benchmarks (about 1 GB of RAM)." << endl;
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -5,9 +5,15 @@
 
 #include <iostream>
 #include <iomanip>
+#include <fstream>
 #include <vector>
 #include <set>
 #include <algorithm>
+#include <list>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
 
 using namespace std;
 
@@ -157,7 +163,564 @@ public:
     }
 };
 
-int main() {
+// Streaming working-set tracker: keeps the last delta + 1 references (the
+// same window calculateWorkingSet uses) in a ring buffer and a count per
+// page of its occurrences in that window. Each reference adds one page
+// and drops the oldest, so |WS| changes in O(1). Memory is fixed by the
+// window and the page range, not the trace length. Page numbers must lie
+// in [0, numPages).
+class StreamingWorkingSet {
+private:
+    int windowSize;                     // Working set window size (delta)
+    vector<int> window;                 // Ring of the last delta + 1 references
+    vector<uint32_t> pageCount;         // Occurrences of each page in the window
+    size_t head;                        // Next ring slot to overwrite
+    long long time;                     // References seen so far
+    int currentSize;                    // |WS| after the latest reference
+    
+    long long sizeSum;
+    int minSize, maxSize;
+    
+    long long snapshotInterval;         // 0 = no snapshots
+    vector<pair<long long, vector<int>>> snapshots;   // (time, sorted pages)
+    
+    void takeSnapshot() {
+        size_t filled = static_cast<size_t>(min<long long>(time, static_cast<long long>(window.size())));
+        vector<int> pages(window.begin(), window.begin() + filled);
+        sort(pages.begin(), pages.end());
+        pages.erase(unique(pages.begin(), pages.end()), pages.end());
+        snapshots.push_back({time, pages});
+    }
+    
+public:
+    StreamingWorkingSet(int delta, int numPages) 
+        : windowSize(delta), window(delta + 1), pageCount(numPages, 0), snapshotInterval(0) {
+        reset();
+    }
+    
+    void reset() {
+        fill(pageCount.begin(), pageCount.end(), 0);
+        head = 0;
+        time = 0;
+        currentSize = 0;
+        sizeSum = 0;
+        minSize = INT_MAX;
+        maxSize = 0;
+        snapshots.clear();
+    }
+    
+    // Records the full working set every interval references (0 = never)
+    void setSnapshotInterval(long long interval) {
+        snapshotInterval = interval;
+    }
+    
+    // Adds one reference and returns |WS| at that time
+    int reference(int page) {
+        if (time >= static_cast<long long>(window.size())) {
+            if (--pageCount[window[head]] == 0) currentSize--;
+        }
+        if (pageCount[page]++ == 0) currentSize++;
+        window[head] = page;
+        head = (head + 1 == window.size()) ? 0 : head + 1;
+        time++;
+        
+        sizeSum += currentSize;
+        minSize = min(minSize, currentSize);
+        maxSize = max(maxSize, currentSize);
+        if (snapshotInterval != 0 && time % snapshotInterval == 0) takeSnapshot();
+        return currentSize;
+    }
+    
+    // Processes a block of references; sizes, if not null, receives |WS|
+    // after each one
+    void processBlock(const int* refs, size_t count, int* sizes = nullptr) {
+        for (size_t i = 0; i < count; i++) {
+            int size = reference(refs[i]);
+            if (sizes) sizes[i] = size;
+        }
+    }
+    
+    int getWindowSize() const { return windowSize; }
+    long long getTime() const { return time; }
+    int getCurrentSize() const { return currentSize; }
+    int getMinSize() const { return time ? minSize : 0; }
+    int getMaxSize() const { return maxSize; }
+    double getAverageSize() const { return time ? static_cast<double>(sizeSum) / time : 0.0; }
+    const vector<pair<long long, vector<int>>>& getSnapshots() const { return snapshots; }
+};
+
+// Reference generator with locality: 95% of references fall in a 4096-page
+// working set that moves every 16M references, the rest are uniform over
+// numPages pages
+class LocalityTrace {
+private:
+    long long remaining;
+    long long position;
+    uint32_t state;
+    int numPages;
+    
+public:
+    LocalityTrace(long long length, int pages, uint32_t seed = 2463534242u) 
+        : remaining(length), position(0), state(seed), numPages(pages) {}
+    
+    size_t operator()(int* buffer, size_t max) {
+        size_t count = static_cast<size_t>(min<long long>(remaining, static_cast<long long>(max)));
+        for (size_t i = 0; i < count; i++, position++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            int base = static_cast<int>((position >> 24) * 4096 % (numPages - 4096));
+            buffer[i] = (state % 100 < 95) ? base + static_cast<int>(state >> 20) 
+                                           : static_cast<int>((state >> 4) % numPages);
+        }
+        remaining -= count;
+        return count;
+    }
+};
+
+// delta = 1M over a long trace in constant memory; only the size series is
+// consumed, plus a snapshot of the working set every quarter of the trace
+void benchmarkStreamingWorkingSet(long long numReferences, int delta) {
+    const int numPages = 1 << 22;
+    cout << "\n\n=== Streaming Working Set: " << numReferences << " references, delta = " 
+         << delta << " ===" << endl;
+    
+    StreamingWorkingSet tracker(delta, numPages);
+    tracker.setSnapshotInterval(numReferences / 4);
+    LocalityTrace trace(numReferences, numPages);
+    
+    const size_t blockSize = 1 << 16;
+    vector<int> block(blockSize);
+    vector<int> sizes(blockSize);
+    double seconds = 0;
+    size_t count;
+    while ((count = trace(block.data(), blockSize)) > 0) {
+        auto start = chrono::steady_clock::now();
+        tracker.processBlock(block.data(), count, sizes.data());
+        seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    
+    cout << "Average |WS|: " << fixed << setprecision(2) << tracker.getAverageSize()
+         << ", Min: " << tracker.getMinSize() << ", Max: " << tracker.getMaxSize() << endl;
+    for (const auto& snapshot : tracker.getSnapshots()) {
+        cout << "  t = " << snapshot.first << ": " << snapshot.second.size() << " pages" << endl;
+    }
+    cout << setprecision(2) << seconds << " s, " << setprecision(1) 
+         << numReferences / seconds / 1e6 << "M refs/s" << endl;
+}
+
+// Working-set size for every window size from one pass (Denning and
+// Schwartz). A reference contributes to the working set at the following
+// times until its page is referenced again or it leaves the window, so
+// with window T = delta + 1 references it counts min(T, g) times, where g
+// is the gap to the next reference of the same page (cut off at the end
+// of the trace). Summing over references:
+//   S(T) = S(T - 1) + (number of references with gap >= T)
+// and the average |WS| is S(T) / n. One histogram of gaps therefore gives
+// the exact average for all deltas up to maxDelta.
+// The maximum is not a function of the gaps, so it is tracked exactly, in
+// the same pass, only for the deltas listed in maxDeltas.
+class WorkingSetCurve {
+private:
+    int maxDelta;
+    vector<long long> gapCount;         // gapCount[g], last bucket holds g >= maxDelta + 1
+    vector<long long> lastSeen;         // Time of each page's latest reference, -1 = never
+    vector<int> trackedDeltas;
+    vector<StreamingWorkingSet> maxTrackers;
+    long long time;
+    mutable vector<double> curveCache;  // averageCurve() as of curveTime
+    mutable long long curveTime;
+    
+    void countGap(long long gap) {
+        gapCount[min<long long>(gap, maxDelta + 1)]++;
+    }
+    
+public:
+    WorkingSetCurve(int maxD, int numPages, const vector<int>& maxDeltas = {})
+        : maxDelta(maxD), gapCount(maxD + 2, 0), lastSeen(numPages, -1), 
+          trackedDeltas(maxDeltas), time(0), curveTime(-1) {
+        for (int delta : maxDeltas) {
+            maxTrackers.emplace_back(delta, numPages);
+        }
+    }
+    
+    void reference(int page) {
+        if (lastSeen[page] >= 0) countGap(time - lastSeen[page]);
+        lastSeen[page] = time++;
+        for (auto& tracker : maxTrackers) {
+            tracker.reference(page);
+        }
+    }
+    
+    void processBlock(const int* refs, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            reference(refs[i]);
+        }
+    }
+    
+    long long getTime() const { return time; }
+    
+    // Average |WS| for delta = 0..maxDelta. Built in O(numPages + maxDelta)
+    // and cached until the next reference.
+    const vector<double>& averageCurve() const {
+        if (curveTime == time) return curveCache;
+        curveTime = time;
+        
+        // Pages still live at the end have their gap cut off there
+        vector<long long> gaps = gapCount;
+        for (long long last : lastSeen) {
+            if (last >= 0) gaps[min<long long>(time - last, maxDelta + 1)]++;
+        }
+        
+        vector<double>& curve = curveCache;
+        curve.assign(maxDelta + 1, 0.0);
+        if (time == 0) return curve;
+        long long atLeast = time;       // References with gap >= T, starting at T = 1
+        long long sum = 0;
+        for (int window = 1; window <= maxDelta + 1; window++) {
+            sum += atLeast;
+            curve[window - 1] = static_cast<double>(sum) / time;
+            atLeast -= gaps[window];
+        }
+        return curve;
+    }
+    
+    double getAverageSize(int delta) const {
+        return averageCurve()[delta];
+    }
+    
+    // Maximum |WS| for a delta listed in maxDeltas, -1 otherwise
+    int getMaxSize(int delta) const {
+        for (size_t i = 0; i < trackedDeltas.size(); i++) {
+            if (trackedDeltas[i] == delta) return maxTrackers[i].getMaxSize();
+        }
+        return -1;
+    }
+    
+    // CSV with one row per stride deltas; max_wss is empty where untracked
+    void writeCSV(ostream& out, int stride = 1) const {
+        const vector<double>& curve = averageCurve();
+        out << "delta,avg_wss,max_wss" << endl;
+        for (int delta = 0; delta <= maxDelta; delta++) {
+            int maxSize = getMaxSize(delta);
+            if (delta % stride != 0 && maxSize < 0) continue;
+            out << delta << "," << fixed << setprecision(4) << curve[delta] << ",";
+            if (maxSize >= 0) out << maxSize;
+            out << "\n";
+        }
+    }
+};
+
+// The WSS(delta) curve up to 1M for a long trace from a single scan,
+// written to working_set_curve.csv
+void benchmarkWorkingSetCurve(long long numReferences, int maxDelta) {
+    const int numPages = 1 << 22;
+    cout << "\n\n=== Working Set Curve: " << numReferences << " references, delta up to " 
+         << maxDelta << " ===" << endl;
+    
+    vector<int> tracked = {1000, 100000, maxDelta};
+    WorkingSetCurve curve(maxDelta, numPages, tracked);
+    LocalityTrace trace(numReferences, numPages);
+    
+    const size_t blockSize = 1 << 16;
+    vector<int> block(blockSize);
+    auto start = chrono::steady_clock::now();
+    size_t count;
+    while ((count = trace(block.data(), blockSize)) > 0) {
+        curve.processBlock(block.data(), count);
+    }
+    const vector<double>& averages = curve.averageCurve();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    cout << left << setw(12) << "Delta" << setw(16) << "Avg WS Size" << "Max WS Size" << endl;
+    cout << string(40, '-') << endl;
+    for (int delta : tracked) {
+        cout << left << setw(12) << delta << setw(16) << fixed << setprecision(2) 
+             << averages[delta] << curve.getMaxSize(delta) << endl;
+    }
+    
+    ofstream csv("working_set_curve.csv");
+    curve.writeCSV(csv, 1000);
+    cout << maxDelta + 1 << " window sizes in " << setprecision(2) << seconds 
+         << " s; curve written to working_set_curve.csv" << endl;
+}
+
+// Reference stream of one process: phases of phaseLength references, each
+// spread uniformly over its own set of wsPages pages out of numPages
+class PhaseTrace {
+private:
+    int numPages;
+    int wsPages;
+    long long phaseLength;
+    long long position;
+    int base;
+    uint32_t state;
+    
+public:
+    PhaseTrace(int pages, int ws, long long phase, uint32_t seed)
+        : numPages(pages), wsPages(ws), phaseLength(phase), position(0), base(0), state(seed) {}
+    
+    int next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        if (position++ % phaseLength == 0) {
+            base = static_cast<int>(state % (numPages - wsPages));
+        }
+        return base + static_cast<int>((state >> 8) % wsPages);
+    }
+};
+
+// Multiprogrammed memory controller. Processes run round robin on one CPU;
+// a page fault blocks the process on a single paging disk for
+// faultServiceTime while others run. Each process replaces LRU within its
+// own frame allocation.
+//   EQUAL_SHARE: every process is active with totalFrames / N frames.
+//   WORKING_SET: every controlInterval the controller sizes each active
+//   process's allocation to its live working set (StreamingWorkingSet over
+//   its own references). When the working sets no longer fit, it swaps out
+//   the most recently admitted process; suspended processes are admitted
+//   again, oldest first, once their last measured working set fits.
+//   Processes never run before are admitted one per interval, so their
+//   working sets are measured before more load is added.
+class MemoryController {
+public:
+    enum Mode { EQUAL_SHARE, WORKING_SET };
+    
+private:
+    enum State { READY, WAITING, SUSPENDED, FINISHED };
+    
+    struct Process {
+        PhaseTrace trace;
+        long long remaining;
+        StreamingWorkingSet workingSet;
+        list<int> lru;                  // Resident pages, most recent at the front
+        vector<list<int>::iterator> position;
+        vector<char> resident;
+        int allocation;
+        int lastWorkingSet;             // Measured when last swapped out, 0 = never ran
+        State state;
+        long long readyAt;              // End of the outstanding fault
+        long long admittedAt;
+        
+        Process(const PhaseTrace& t, long long refs, int delta, int numPages)
+            : trace(t), remaining(refs), workingSet(delta, numPages), position(numPages),
+              resident(numPages, 0), allocation(0), lastWorkingSet(0), state(SUSPENDED),
+              readyAt(0), admittedAt(0) {}
+    };
+    
+    int totalFrames;
+    int delta;
+    Mode mode;
+    int numPages;
+    int quantum;                        // References per CPU turn
+    long long faultServiceTime;
+    long long controlInterval;
+    static constexpr int MIN_FRAMES = 8;
+    static constexpr long long DISK_FAULT_TIME = 1000;  // Microseconds, as DISK_ACCESS_TIME in Lab9-6
+    
+    vector<Process> processes;
+    long long time;
+    long long diskFree;                 // When the paging disk finishes its queue
+    long long references;
+    long long faults;
+    long long suspensions;
+    long long activeSamples, activeSum;
+    
+    void evictDownTo(Process& p, int frames) {
+        while (static_cast<int>(p.lru.size()) > max(frames, 0)) {
+            p.resident[p.lru.back()] = 0;
+            p.lru.pop_back();
+        }
+    }
+    
+    bool isActive(const Process& p) const {
+        return p.state == READY || p.state == WAITING;
+    }
+    
+    void suspend(Process& p) {
+        p.lastWorkingSet = max(p.workingSet.getCurrentSize(), MIN_FRAMES);
+        evictDownTo(p, 0);
+        p.allocation = 0;
+        p.state = SUSPENDED;
+        suspensions++;
+    }
+    
+    void control() {
+        int active = 0;
+        int demand = 0;
+        for (Process& p : processes) {
+            if (!isActive(p)) continue;
+            p.allocation = max(p.workingSet.getCurrentSize(), MIN_FRAMES);
+            demand += p.allocation;
+            active++;
+        }
+        
+        // Swap out the newest admissions until the working sets fit
+        while (demand > totalFrames && active > 1) {
+            Process* newest = nullptr;
+            for (Process& p : processes) {
+                if (isActive(p) && (!newest || p.admittedAt > newest->admittedAt)) newest = &p;
+            }
+            demand -= newest->allocation;
+            suspend(*newest);
+            active--;
+        }
+        for (Process& p : processes) {
+            if (isActive(p)) evictDownTo(p, p.allocation);
+        }
+        
+        // Admit suspended processes that fit, oldest first
+        bool admittedUnknown = false;
+        for (Process& p : processes) {
+            if (p.state != SUSPENDED) continue;
+            bool unknown = (p.lastWorkingSet == 0);
+            int need = unknown ? MIN_FRAMES : p.lastWorkingSet;
+            if ((unknown && admittedUnknown) || (active > 0 && demand + need > totalFrames)) continue;
+            p.allocation = need;
+            p.state = READY;
+            p.admittedAt = time;
+            demand += need;
+            active++;
+            admittedUnknown = admittedUnknown || unknown;
+        }
+        
+        activeSum += active;
+        activeSamples++;
+    }
+    
+    // Runs p for up to one quantum; stops early on a fault or at the end
+    void runQuantum(Process& p) {
+        for (int i = 0; i < quantum && p.remaining > 0; i++) {
+            int page = p.trace.next();
+            p.workingSet.reference(page);
+            p.remaining--;
+            references++;
+            time++;
+            
+            if (p.resident[page]) {
+                p.lru.splice(p.lru.begin(), p.lru, p.position[page]);
+                continue;
+            }
+            
+            faults++;
+            evictDownTo(p, p.allocation - 1);
+            p.lru.push_front(page);
+            p.position[page] = p.lru.begin();
+            p.resident[page] = 1;
+            p.readyAt = max(time, diskFree) + faultServiceTime;
+            diskFree = p.readyAt;
+            p.state = WAITING;
+            return;
+        }
+        
+        if (p.remaining == 0) {
+            evictDownTo(p, 0);
+            p.allocation = 0;
+            p.state = FINISHED;
+        }
+    }
+    
+public:
+    MemoryController(int frames, int d, Mode m, int pages = 1024)
+        : totalFrames(frames), delta(d), mode(m), numPages(pages), quantum(100),
+          faultServiceTime(DISK_FAULT_TIME), controlInterval(2000), time(0), diskFree(0),
+          references(0), faults(0), suspensions(0), activeSamples(0), activeSum(0) {}
+    
+    void addProcess(long long numReferences, int wsPages, long long phaseLength, uint32_t seed) {
+        processes.emplace_back(PhaseTrace(numPages, wsPages, phaseLength, seed), 
+                               numReferences, delta, numPages);
+    }
+    
+    void run() {
+        if (mode == EQUAL_SHARE) {
+            for (Process& p : processes) {
+                p.allocation = max(totalFrames / static_cast<int>(processes.size()), 1);
+                p.state = READY;
+            }
+        }
+        
+        size_t next = 0;
+        long long nextControl = 0;
+        int unfinished = static_cast<int>(processes.size());
+        while (unfinished > 0) {
+            if (mode == WORKING_SET && time >= nextControl) {
+                control();
+                nextControl = time + controlInterval;
+            }
+            
+            // Next ready process in round-robin order
+            Process* chosen = nullptr;
+            long long earliest = LLONG_MAX;
+            for (size_t i = 0; i < processes.size() && !chosen; i++) {
+                Process& p = processes[(next + i) % processes.size()];
+                if (p.state == WAITING && p.readyAt <= time) p.state = READY;
+                if (p.state == READY) {
+                    chosen = &p;
+                    next = (next + i + 1) % processes.size();
+                } else if (p.state == WAITING) {
+                    earliest = min(earliest, p.readyAt);
+                }
+            }
+            
+            if (!chosen) {
+                // CPU idles until a fault completes or the controller runs
+                time = (earliest == LLONG_MAX) ? nextControl 
+                                               : (mode == WORKING_SET ? min(earliest, nextControl) : earliest);
+                continue;
+            }
+            
+            runQuantum(*chosen);
+            if (chosen->state == FINISHED) {
+                unfinished--;
+                nextControl = time;     // Hand the freed frames out at once
+            }
+        }
+    }
+    
+    double getFaultRate() const { return references ? faults * 100.0 / references : 0.0; }
+    // References completed per millisecond of simulated time
+    double getThroughput() const { return time ? references * 1000.0 / time : 0.0; }
+    double getAverageActive() const { 
+        return activeSamples ? static_cast<double>(activeSum) / activeSamples 
+                             : static_cast<double>(processes.size());
+    }
+    long long getSuspensions() const { return suspensions; }
+};
+
+// Throughput against the multiprogramming level: with equal shares, the
+// working sets stop fitting and the paging disk saturates; the working-set
+// controller keeps only as many processes active as fit
+void compareMultiprogramming(int totalFrames, int maxLevel) {
+    cout << "\n\n=== Thrashing Control: " << totalFrames << " frames, working sets of 40-64 pages ===" << endl;
+    cout << left << setw(6) << "MPL" 
+         << setw(14) << "Equal Fault%" << setw(16) << "Equal Refs/ms"
+         << setw(12) << "WS Fault%" << setw(14) << "WS Refs/ms" 
+         << setw(12) << "WS Active" << "Swap-outs" << endl;
+    cout << string(84, '-') << endl;
+    
+    for (int level = 1; level <= maxLevel; level++) {
+        MemoryController equal(totalFrames, 500, MemoryController::EQUAL_SHARE);
+        MemoryController controlled(totalFrames, 500, MemoryController::WORKING_SET);
+        for (int i = 0; i < level; i++) {
+            equal.addProcess(300000, 40 + 8 * (i % 4), 100000, 1000 + i);
+            controlled.addProcess(300000, 40 + 8 * (i % 4), 100000, 1000 + i);
+        }
+        equal.run();
+        controlled.run();
+        
+        cout << left << setw(6) << level << fixed << setprecision(3)
+             << setw(14) << equal.getFaultRate() << setprecision(1) << setw(16) << equal.getThroughput()
+             << setprecision(3) << setw(12) << controlled.getFaultRate() 
+             << setprecision(1) << setw(14) << controlled.getThroughput()
+             << setw(12) << controlled.getAverageActive() << controlled.getSuspensions() << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // The long benchmarks run on request
+    bool runBenchmarks = argc > 1 && string(argv[1]) == "--benchmark";
+    
     cout << "=== Working Set Simulator ===" << endl;
     
     // Test case 1: Small window
@@ -195,23 +758,45 @@ int main() {
          << setw(20) << "Max WS Size" << endl;
     cout << string(55, '-') << endl;
     
+    // Every window size from one pass over the reference string
+    WorkingSetCurve curve(11, 6, {2, 3, 4, 5, 6});
+    curve.processBlock(refString2.data(), refString2.size());
     for (int delta = 2; delta <= 6; delta++) {
-        WorkingSetSimulator wss(delta);
-        wss.processReferenceString(refString2);
-        
-        // Calculate statistics without displaying
-        double sum = 0;
-        int maxSize = 0;
-        for (int t = 0; t < refString2.size(); t++) {
-            set<int> ws = wss.calculateWorkingSet(t);
-            sum += ws.size();
-            maxSize = max(maxSize, (int)ws.size());
-        }
-        double avgSize = sum / refString2.size();
-        
         cout << left << setw(15) << delta 
-             << setw(20) << fixed << setprecision(2) << avgSize
-             << setw(20) << maxSize << endl;
+             << setw(20) << fixed << setprecision(2) << curve.getAverageSize(delta)
+             << setw(20) << curve.getMaxSize(delta) << endl;
+    }
+    
+    cout << "\nFull curve (CSV):" << endl;
+    curve.writeCSV(cout);
+    
+    // The streaming tracker must reproduce the per-step set sizes
+    bool agree = true;
+    for (int delta = 1; delta <= 8; delta++) {
+        StreamingWorkingSet streaming(delta, 8);
+        streaming.setSnapshotInterval(1);
+        for (const vector<int>* refString : {&refString1, &refString2}) {
+            streaming.reset();
+            for (int t = 0; t < (int)refString->size(); t++) {
+                set<int> ws(refString->begin() + max(0, t - delta), refString->begin() + t + 1);
+                agree = agree && streaming.reference((*refString)[t]) == (int)ws.size()
+                              && streaming.getSnapshots()[t].second == vector<int>(ws.begin(), ws.end());
+            }
+            WorkingSetCurve oneDelta(delta, 8);
+            oneDelta.processBlock(refString->data(), refString->size());
+            agree = agree && fabs(oneDelta.getAverageSize(delta) - streaming.getAverageSize()) < 1e-9;
+        }
+    }
+    cout << "\nStreaming tracker " << (agree ? "matches" : "DIFFERS FROM") 
+         << " the set-based working sets (window sizes 1-8)" << endl;
+    
+    compareMultiprogramming(256, 12);
+    
+    if (runBenchmarks) {
+        benchmarkStreamingWorkingSet(1000000000LL, 1000000);
+        benchmarkWorkingSetCurve(100000000LL, 1000000);
+    } else {
+        cout << "\nRun with --benchmark for the streaming and curve benchmarks (writes working_set_curve.csv)." << endl;
     }
     
     return 0;
@@ -8,6 +8,11 @@
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
@@ -212,7 +217,582 @@ public:
     }
 };
 
-int main() {
+// One level of a set-associative TLB. Entries are tagged with the virtual
+// page number and an address-space ID (ASID/PCID), so switching processes
+// needs no flush. Every set has a 16-byte row of one-byte tag hints: a
+// lookup compares the whole row in one SSE2 instruction and checks the
+// full tag only for ways whose hint matches, so a miss usually touches a
+// single 16-byte row. Tags and frames are flat arrays, set after set.
+// Replacement is tree pseudo-LRU with ways - 1 bits per set. Entries and
+// ways must be powers of two, with 2 to 16 ways.
+class SetAssociativeTLB {
+public:
+    static constexpr int ASID_BITS = 12;
+    
+private:
+    static constexpr int HINT_ROW = 16;
+    static constexpr uint8_t EMPTY_HINT = 0;
+    
+    // One set's hints; alignas keeps every row loadable with an aligned load
+    // and lets the vector below be copied and moved like any other member
+    struct alignas(HINT_ROW) HintRow {
+        uint8_t hint[HINT_ROW];
+    };
+    
+    int numSets;
+    int ways;
+    int wayBits;
+    uint32_t wayMask;                   // Low `ways` bits set
+    vector<HintRow> hints;              // numSets rows
+    vector<uint64_t> tags;              // numSets * ways
+    vector<uint64_t> frames;
+    vector<uint32_t> plru;              // Tree bits, node n at bit n (root = 1)
+    uint32_t touchClear[HINT_ROW];      // Per way: tree bits on its path...
+    uint32_t touchSet[HINT_ROW];        // ...and their values after a touch
+    long long lookups;
+    long long hits;
+    
+    static uint64_t makeTag(uint64_t vpn, int asid) {
+        return (vpn << ASID_BITS) | static_cast<uint64_t>(asid);
+    }
+    
+    // Never EMPTY_HINT, so empty ways can be found with the same compare
+    static uint8_t makeHint(uint64_t tag) {
+        return static_cast<uint8_t>(0x80 | ((tag * 0x9E3779B97F4A7C15ULL) >> 57));
+    }
+    
+    // Bit w set when way w of the set has the given hint
+    uint32_t matchHints(int set, uint8_t hint) const {
+        const uint8_t* row = hints[set].hint;
+#ifdef __SSE2__
+        __m128i eq = _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(row)), _mm_set1_epi8(static_cast<char>(hint)));
+        return static_cast<uint32_t>(_mm_movemask_epi8(eq)) & wayMask;
+#else
+        uint32_t mask = 0;
+        for (int way = 0; way < ways; way++) {
+            mask |= static_cast<uint32_t>(row[way] == hint) << way;
+        }
+        return mask;
+#endif
+    }
+    
+    // Points every node on the way's path at the other half
+    void touch(int set, int way) {
+        plru[set] = (plru[set] & ~touchClear[way]) | touchSet[way];
+    }
+    
+    int victim(int set) const {
+        uint32_t bits = plru[set];
+        int node = 1;
+        for (int level = 0; level < wayBits; level++) {
+            node = 2 * node + static_cast<int>((bits >> node) & 1);
+        }
+        return node - ways;
+    }
+    
+public:
+    SetAssociativeTLB(int entries, int numWays) 
+        : numSets(entries / numWays), ways(numWays), wayBits(0), wayMask((1u << numWays) - 1),
+          lookups(0), hits(0) {
+        while ((1 << wayBits) < ways) wayBits++;
+        for (int way = 0; way < ways; way++) {
+            touchClear[way] = touchSet[way] = 0;
+            int node = 1;
+            for (int level = wayBits - 1; level >= 0; level--) {
+                uint32_t direction = (way >> level) & 1;
+                touchClear[way] |= 1u << node;
+                touchSet[way] |= (direction ^ 1) << node;
+                node = 2 * node + static_cast<int>(direction);
+            }
+        }
+        HintRow empty;
+        fill(empty.hint, empty.hint + HINT_ROW, EMPTY_HINT);
+        hints.assign(numSets, empty);
+        tags.assign(static_cast<size_t>(numSets) * ways, 0);
+        frames.assign(static_cast<size_t>(numSets) * ways, 0);
+        plru.assign(numSets, 0);
+    }
+    
+    bool lookup(uint64_t vpn, int asid, uint64_t& frame) {
+        lookups++;
+        int set = static_cast<int>(vpn & (numSets - 1));
+        uint64_t tag = makeTag(vpn, asid);
+        size_t base = static_cast<size_t>(set) * ways;
+        for (uint32_t match = matchHints(set, makeHint(tag)); match != 0; match &= match - 1) {
+            int way = __builtin_ctz(match);
+            if (tags[base + way] == tag) {
+                touch(set, way);
+                hits++;
+                frame = frames[base + way];
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Fills an empty way if the set has one, otherwise the PLRU victim
+    void insert(uint64_t vpn, int asid, uint64_t frame) {
+        int set = static_cast<int>(vpn & (numSets - 1));
+        uint32_t empty = matchHints(set, EMPTY_HINT);
+        int way = empty ? __builtin_ctz(empty) : victim(set);
+        uint64_t tag = makeTag(vpn, asid);
+        hints[set].hint[way] = makeHint(tag);
+        tags[static_cast<size_t>(set) * ways + way] = tag;
+        frames[static_cast<size_t>(set) * ways + way] = frame;
+        touch(set, way);
+    }
+    
+    // Drops the entry for one page, if cached (INVLPG)
+    void invalidatePage(uint64_t vpn, int asid) {
+        int set = static_cast<int>(vpn & (numSets - 1));
+        uint64_t tag = makeTag(vpn, asid);
+        for (uint32_t match = matchHints(set, makeHint(tag)); match != 0; match &= match - 1) {
+            int way = __builtin_ctz(match);
+            if (tags[static_cast<size_t>(set) * ways + way] == tag) {
+                hints[set].hint[way] = EMPTY_HINT;
+            }
+        }
+    }
+    
+    // Drops every entry of one address space (process exit, ASID reuse)
+    void invalidateASID(int asid) {
+        for (int set = 0; set < numSets; set++) {
+            for (int way = 0; way < ways; way++) {
+                uint8_t& hint = hints[set].hint[way];
+                if (hint != EMPTY_HINT && static_cast<int>(tags[static_cast<size_t>(set) * ways + way] & ((1u << ASID_BITS) - 1)) == asid) {
+                    hint = EMPTY_HINT;
+                }
+            }
+        }
+    }
+    
+    void flush() {
+        for (HintRow& row : hints) {
+            fill(row.hint, row.hint + HINT_ROW, EMPTY_HINT);
+        }
+    }
+    
+    int getEntries() const { return numSets * ways; }
+    int getWays() const { return ways; }
+    long long getLookups() const { return lookups; }
+    long long getHits() const { return hits; }
+    double getHitRatio() const { return lookups ? hits * 100.0 / lookups : 0.0; }
+};
+
+// Separate L1 instruction and data TLBs backed by a unified L2 TLB. A
+// miss in both walks the page table and is charged PAGE_WALK_LEVELS
+// memory accesses. The page table is a caller-owned frame per page when
+// set with setPageTable, otherwise walkPageTable stands in for it.
+class TLBHierarchy {
+private:
+    SetAssociativeTLB itlb;
+    SetAssociativeTLB dtlb;
+    SetAssociativeTLB stlb;
+    bool useASIDs;                      // Without ASIDs every switch flushes
+    const vector<uint64_t>* pageTable;
+    long long translations;
+    long long walks;
+    long long flushes;
+    
+    static uint64_t walkPageTable(uint64_t vpn, int asid) {
+        return ((vpn * 0x9E3779B97F4A7C15ULL) ^ static_cast<uint64_t>(asid)) >> 36;
+    }
+    
+public:
+    // Latencies in nanoseconds, on the same scale as TLBSimulator
+    static constexpr int L1_TLB_TIME = 20;
+    static constexpr int L2_TLB_TIME = 40;
+    static constexpr int MEMORY_ACCESS_TIME = 100;
+    static constexpr int PAGE_WALK_LEVELS = 4;
+    
+    TLBHierarchy(int itlbEntries, int itlbWays, int dtlbEntries, int dtlbWays, 
+                 int l2Entries, int l2Ways, bool asids = true)
+        : itlb(itlbEntries, itlbWays), dtlb(dtlbEntries, dtlbWays), stlb(l2Entries, l2Ways),
+          useASIDs(asids), pageTable(nullptr), translations(0), walks(0), flushes(0) {}
+    
+    void setPageTable(const vector<uint64_t>* table) {
+        pageTable = table;
+    }
+    
+    uint64_t translate(uint64_t virtualAddress, int asid, bool instruction) {
+        translations++;
+        if (!useASIDs) asid = 0;
+        uint64_t vpn = virtualAddress >> 12;
+        uint64_t frame;
+        SetAssociativeTLB& l1 = instruction ? itlb : dtlb;
+        if (!l1.lookup(vpn, asid, frame)) {
+            if (!stlb.lookup(vpn, asid, frame)) {
+                walks++;
+                frame = pageTable ? (*pageTable)[vpn] : walkPageTable(vpn, asid);
+                stlb.insert(vpn, asid, frame);
+            }
+            l1.insert(vpn, asid, frame);
+        }
+        return (frame << 12) | (virtualAddress & 0xFFF);
+    }
+    
+    // kinds[i] != 0 marks an instruction fetch
+    uint64_t processBlock(const uint64_t* addresses, const uint16_t* asids, const uint8_t* kinds, size_t count) {
+        uint64_t checksum = 0;
+        for (size_t i = 0; i < count; i++) {
+            checksum += translate(addresses[i], asids[i], kinds[i] != 0);
+        }
+        return checksum;
+    }
+    
+    // Called when the CPU switches address spaces
+    void contextSwitch() {
+        if (!useASIDs) flushAll();
+    }
+    
+    void flushAll() {
+        itlb.flush();
+        dtlb.flush();
+        stlb.flush();
+        flushes++;
+    }
+    
+    // Shootdown target: drops one page from every level
+    void invalidatePage(uint64_t vpn, int asid = 1) {
+        if (!useASIDs) asid = 0;
+        itlb.invalidatePage(vpn, asid);
+        dtlb.invalidatePage(vpn, asid);
+        stlb.invalidatePage(vpn, asid);
+    }
+    
+    // Translation plus data access time of all translations so far, in ns
+    double getTotalTime() const {
+        return translations * static_cast<double>(L1_TLB_TIME + MEMORY_ACCESS_TIME) 
+             + stlb.getLookups() * static_cast<double>(L2_TLB_TIME)
+             + walks * static_cast<double>(PAGE_WALK_LEVELS * MEMORY_ACCESS_TIME);
+    }
+    
+    // Average translation plus data access time in nanoseconds
+    double getEffectiveAccessTime() const {
+        return translations ? getTotalTime() / translations : 0.0;
+    }
+    
+    long long getTranslations() const { return translations; }
+    long long getWalks() const { return walks; }
+    
+    void displayStatistics() const {
+        cout << "Translations: " << translations << (useASIDs ? " (ASID-tagged)" : " (flush on switch)") << endl;
+        cout << fixed << setprecision(3);
+        cout << "  L1 ITLB " << itlb.getEntries() << "x" << itlb.getWays() << "-way hit ratio: " 
+             << itlb.getHitRatio() << "% of " << itlb.getLookups() << endl;
+        cout << "  L1 DTLB " << dtlb.getEntries() << "x" << dtlb.getWays() << "-way hit ratio: " 
+             << dtlb.getHitRatio() << "% of " << dtlb.getLookups() << endl;
+        cout << "  L2 STLB " << stlb.getEntries() << "x" << stlb.getWays() << "-way hit ratio: " 
+             << stlb.getHitRatio() << "% of " << stlb.getLookups() << " L1 misses" << endl;
+        cout << "  Page walks: " << walks << " (" << (translations ? walks * 100.0 / translations : 0.0) 
+             << "%), flushes: " << flushes << endl;
+        cout << "  Effective Access Time: " << setprecision(2) << getEffectiveAccessTime() 
+             << " ns (translation + data access)" << endl;
+    }
+};
+
+// Address stream of several processes sharing one CPU. Every process
+// uses the same virtual layout. One reference in four is an instruction
+// fetch from 32 hot code pages. Data references go 80% to 32 hot
+// stack/heap pages, 15% to a 512-page window drifting through memory,
+// and 5% anywhere in 1M pages.
+class TranslationTrace {
+private:
+    long long remaining;
+    long long position;
+    uint64_t state;
+    int numProcesses;
+    long long switchInterval;
+    
+public:
+    TranslationTrace(long long length, int processes, long long interval)
+        : remaining(length), position(0), state(88172645463325252ULL), 
+          numProcesses(processes), switchInterval(interval) {}
+    
+    long long getSwitchInterval() const { return switchInterval; }
+    
+    size_t operator()(uint64_t* addresses, uint16_t* asids, uint8_t* kinds, size_t max) {
+        size_t count = static_cast<size_t>(min<long long>(remaining, static_cast<long long>(max)));
+        for (size_t i = 0; i < count; i++, position++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            int process = static_cast<int>((position / switchInterval) % numProcesses);
+            uint64_t offset = state >> 52;
+            uint64_t page;
+            uint64_t choice = (state >> 16) % 100;
+            kinds[i] = (state & 3) == 0;
+            if (kinds[i]) {
+                page = 0x400 + ((state >> 8) & 31);
+            } else if (choice < 80) {
+                page = 0x7FFF00 + ((state >> 24) & 31);
+            } else if (choice < 95) {
+                page = 0x100000 + ((position >> 16) & 0xFFFF) + ((state >> 24) & 511);
+            } else {
+                page = 0x100000 + ((state >> 24) & 0xFFFFF);
+            }
+            addresses[i] = (page << 12) | offset;
+            asids[i] = static_cast<uint16_t>(process + 1);
+        }
+        remaining -= count;
+        return count;
+    }
+};
+
+void runTranslationTrace(TLBHierarchy& tlb, long long numTranslations, int processes, long long interval,
+                         double& seconds) {
+    TranslationTrace trace(numTranslations, processes, interval);
+    const size_t blockSize = 1 << 16;
+    vector<uint64_t> addresses(blockSize);
+    vector<uint16_t> asids(blockSize);
+    vector<uint8_t> kinds(blockSize);
+    seconds = 0;
+    uint64_t checksum = 0;
+    uint16_t current = 0;
+    size_t count;
+    while ((count = trace(addresses.data(), asids.data(), kinds.data(), blockSize)) > 0) {
+        auto start = chrono::steady_clock::now();
+        // Split the block at context switches
+        size_t begin = 0;
+        for (size_t i = 0; i <= count; i++) {
+            if (i == count || asids[i] != current) {
+                checksum += tlb.processBlock(&addresses[begin], &asids[begin], &kinds[begin], i - begin);
+                if (i == count) break;
+                current = asids[i];
+                tlb.contextSwitch();
+                begin = i;
+            }
+        }
+        seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    if (checksum == 0) cout << "  (empty trace)" << endl;
+}
+
+// Several cores, each with its own TLB hierarchy, running threads of one
+// process over a shared page table. Threads keep unmapping and remapping
+// ranges of pages (munmap/mmap), and stale TLB entries on the other cores
+// are removed in one of three ways:
+//   PER_PAGE_IPI: one interrupt round to every other core per page.
+//   BATCHED_IPI:  one round per range carrying the page list; targets
+//                 flush everything when the range exceeds the ceiling.
+//   LAZY:         no interrupts; the global TLB generation is bumped and
+//                 each core flushes at its next timer tick. The old frames
+//                 cannot be reused until every core has ticked, and
+//                 translations served by stale entries in that window are
+//                 counted.
+// Time is simulated per core in nanoseconds: translation time from the
+// TLB hierarchy plus shootdown stalls.
+class ShootdownSimulator {
+public:
+    enum Strategy { NO_UNMAPS, PER_PAGE_IPI, BATCHED_IPI, LAZY };
+    
+    static constexpr double IPI_SEND_TIME = 100;        // Per target, by the initiator
+    static constexpr double IPI_ROUND_TRIP = 1500;      // Delivery until the last ack
+    static constexpr double INTERRUPT_TIME = 1000;      // Handler entry/exit on a target
+    static constexpr double INVLPG_TIME = 50;           // Invalidate one page
+    static constexpr double FLUSH_TIME = 200;           // Flush the whole TLB
+    static constexpr int FLUSH_CEILING = 33;            // Larger ranges flush everything
+    static constexpr double TICK_INTERVAL = 1000000;    // 1 ms timer tick
+    
+private:
+    int numCores;
+    Strategy strategy;
+    int rangePages;                     // Pages per munmap
+    long long unmapInterval;            // Translations per core between its munmaps
+    vector<uint64_t> pageTable;         // Shared: frame of every page
+    vector<TLBHierarchy> tlbs;
+    vector<double> stall;               // Shootdown time charged to each core
+    vector<uint64_t> state;             // Per-core address generator
+    vector<long long> coreGeneration;
+    vector<double> nextTick;
+    long long generation;
+    uint64_t nextFrame;
+    
+    long long unmaps;
+    long long ipis;
+    double initiatorStall;
+    double graceTotal;                  // LAZY: time until all cores ticked
+    long long staleTranslations;
+    
+    double coreTime(int core) const {
+        return tlbs[core].getTotalTime() + stall[core];
+    }
+    
+    // 80% of references go to the core's own 64 hot pages, the rest anywhere
+    uint64_t nextPage(int core) {
+        uint64_t& s = state[core];
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        if ((s >> 20) % 10 < 8) return static_cast<uint64_t>(core) * 64 + ((s >> 40) & 63);
+        return (s >> 30) % pageTable.size();
+    }
+    
+    void unmap(int initiator) {
+        uint64_t first = (state[initiator] >> 11) % (pageTable.size() - rangePages);
+        for (int i = 0; i < rangePages; i++) {
+            pageTable[first + i] = nextFrame++;         // Remapped to fresh frames
+            tlbs[initiator].invalidatePage(first + i);
+        }
+        stall[initiator] += rangePages * INVLPG_TIME;
+        unmaps++;
+        
+        int targets = numCores - 1;
+        if (strategy == LAZY) {
+            // The initiator invalidated this range itself, but it is only
+            // current if it had already flushed every earlier generation
+            generation++;
+            if (coreGeneration[initiator] == generation - 1) coreGeneration[initiator] = generation;
+            double grace = 0;
+            for (int core = 0; core < numCores; core++) {
+                if (coreGeneration[core] < generation) grace = max(grace, nextTick[core] - coreTime(core));
+            }
+            graceTotal += grace;
+            return;
+        }
+        if (targets == 0) return;
+        
+        int rounds = (strategy == PER_PAGE_IPI) ? rangePages : 1;
+        bool fullFlush = (strategy == BATCHED_IPI && rangePages > FLUSH_CEILING);
+        double wait = rounds * (targets * IPI_SEND_TIME + IPI_ROUND_TRIP);
+        stall[initiator] += wait;
+        initiatorStall += wait;
+        ipis += static_cast<long long>(rounds) * targets;
+        
+        for (int core = 0; core < numCores; core++) {
+            if (core == initiator) continue;
+            if (fullFlush) {
+                tlbs[core].flushAll();
+                stall[core] += INTERRUPT_TIME + FLUSH_TIME;
+            } else {
+                for (int i = 0; i < rangePages; i++) {
+                    tlbs[core].invalidatePage(first + i);
+                }
+                stall[core] += rounds * INTERRUPT_TIME + rangePages * INVLPG_TIME;
+            }
+        }
+    }
+    
+public:
+    ShootdownSimulator(int cores, Strategy s, int pages = 16, long long interval = 20000, int numPages = 65536)
+        : numCores(cores), strategy(s), rangePages(pages), unmapInterval(interval), pageTable(numPages),
+          stall(cores, 0), coreGeneration(cores, 0), nextTick(cores, TICK_INTERVAL), generation(0),
+          nextFrame(numPages), unmaps(0), ipis(0), initiatorStall(0), graceTotal(0), staleTranslations(0) {
+        for (int page = 0; page < numPages; page++) {
+            pageTable[page] = page;
+        }
+        for (int core = 0; core < cores; core++) {
+            tlbs.emplace_back(128, 8, 64, 4, 2048, 16);
+            tlbs.back().setPageTable(&pageTable);
+            state.push_back(88172645463325252ULL + 7919ULL * core);
+        }
+    }
+    
+    // Each core runs translationsPerCore translations in quanta of 1000
+    void run(long long translationsPerCore) {
+        const int quantum = 1000;
+        for (long long done = 0; done < translationsPerCore; done += quantum) {
+            for (int core = 0; core < numCores; core++) {
+                TLBHierarchy& tlb = tlbs[core];
+                for (int i = 0; i < quantum; i++) {
+                    uint64_t page = nextPage(core);
+                    uint64_t address = tlb.translate(page << 12, 1, false);
+                    staleTranslations += (address >> 12) != pageTable[page];
+                }
+                
+                if (strategy == LAZY && coreTime(core) >= nextTick[core]) {
+                    if (coreGeneration[core] < generation) {
+                        tlb.flushAll();
+                        stall[core] += FLUSH_TIME;
+                        coreGeneration[core] = generation;
+                    }
+                    nextTick[core] += TICK_INTERVAL * (1 + static_cast<long long>((coreTime(core) - nextTick[core]) / TICK_INTERVAL));
+                }
+                
+                // Every core unmaps once per unmapInterval of its own translations
+                if (strategy != NO_UNMAPS && (done + quantum) % unmapInterval == 0) {
+                    unmap(core);
+                }
+            }
+        }
+    }
+    
+    // Aggregate translations per microsecond of the slowest core's time
+    double getThroughput() const {
+        double makespan = 0;
+        long long translations = 0;
+        for (int core = 0; core < numCores; core++) {
+            makespan = max(makespan, coreTime(core));
+            translations += tlbs[core].getTranslations();
+        }
+        return makespan > 0 ? translations * 1000.0 / makespan : 0.0;
+    }
+    
+    // Initiator wait per munmap, or for LAZY the grace period before the
+    // old frames may be reused, in microseconds
+    double getShootdownLatency() const {
+        if (unmaps == 0) return 0.0;
+        return (strategy == LAZY ? graceTotal : initiatorStall) / unmaps / 1000.0;
+    }
+    
+    long long getUnmaps() const { return unmaps; }
+    long long getIPIs() const { return ipis; }
+    long long getStaleTranslations() const { return staleTranslations; }
+};
+
+// Shootdown cost against core count for a munmap-heavy workload: every
+// core unmaps 16 pages every 20000 translations
+void benchmarkShootdowns(long long translationsPerCore) {
+    cout << "\n\n=== TLB Shootdowns: " << translationsPerCore << " translations per core, "
+         << "16-page munmap every 20000 ===" << endl;
+    cout << left << setw(8) << "Cores" << setw(16) << "Strategy" << setw(10) << "Munmaps"
+         << setw(12) << "IPIs" << setw(16) << "Latency (us)" << setw(18) << "Throughput/us"
+         << setw(12) << "Slowdown" << "Stale" << endl;
+    cout << string(100, '-') << endl;
+    
+    const char* names[] = {"none", "per-page IPI", "batched IPI", "lazy"};
+    for (int cores : {1, 2, 4, 8, 16, 32, 64}) {
+        double baseline = 0;
+        for (int s = ShootdownSimulator::NO_UNMAPS; s <= ShootdownSimulator::LAZY; s++) {
+            ShootdownSimulator sim(cores, static_cast<ShootdownSimulator::Strategy>(s));
+            sim.run(translationsPerCore);
+            double throughput = sim.getThroughput();
+            if (s == ShootdownSimulator::NO_UNMAPS) baseline = throughput;
+            cout << left << setw(8) << cores << setw(16) << names[s] << setw(10) << sim.getUnmaps()
+                 << setw(12) << sim.getIPIs() << fixed << setprecision(2) << setw(16) << sim.getShootdownLatency()
+                 << setprecision(1) << setw(18) << throughput
+                 << setw(12) << (to_string(static_cast<int>((1 - throughput / baseline) * 100 + 0.5)) + "%")
+                 << sim.getStaleTranslations() << endl;
+        }
+    }
+    cout << "Latency: initiator stall per munmap; for lazy, the grace period before the "
+         << "old frames may be reused" << endl;
+}
+
+// 1B translations through a 4-process workload, then ASID tagging against
+// flushing on every context switch
+void benchmarkTLBHierarchy(long long numTranslations) {
+    cout << "\n\n=== Set-Associative TLB Hierarchy: " << numTranslations << " translations ===" << endl;
+    TLBHierarchy tlb(128, 8, 64, 4, 2048, 16);
+    double seconds;
+    runTranslationTrace(tlb, numTranslations, 4, 100000, seconds);
+    tlb.displayStatistics();
+    cout << "  " << fixed << setprecision(2) << seconds << " s, " << setprecision(1) 
+         << numTranslations / seconds / 1e6 << "M translations/s" << endl;
+    
+    long long shorter = numTranslations / 10;
+    cout << "\nContext switch every 10000 translations, " << shorter << " translations:" << endl;
+    for (bool asids : {true, false}) {
+        TLBHierarchy compare(128, 8, 64, 4, 2048, 16, asids);
+        runTranslationTrace(compare, shorter, 4, 10000, seconds);
+        compare.displayStatistics();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // The long benchmarks run on request
+    bool runBenchmarks = argc > 1 && string(argv[1]) == "--benchmark";
+    
     cout << "=== TLB Simulator ===" << endl;
     
     // Initialize page table (page -> frame mappings)
@@ -294,5 +874,23 @@ int main() {
     tlb4.processReferenceString(lowLocality);
     tlb4.displayStatistics();
     
+    // The same patterns through the set-associative hierarchy
+    cout << "\n\n*** Test 4: Set-Associative L1/L2 TLB ***" << endl;
+    for (const vector<int>* pattern : {&highLocality, &lowLocality}) {
+        TLBHierarchy hierarchy(8, 2, 4, 2, 16, 4);
+        for (int page : *pattern) {
+            hierarchy.translate(static_cast<uint64_t>(page) << 12, 1, false);
+        }
+        cout << (pattern == &highLocality ? "\nHigh" : "\nLow") << " locality:" << endl;
+        hierarchy.displayStatistics();
+    }
+    
+    if (runBenchmarks) {
+        benchmarkTLBHierarchy(1000000000LL);
+        benchmarkShootdowns(400000);
+    } else {
+        cout << "\nRun with --benchmark for the 1B-translation TLB and multi-core shootdown benchmarks (about a minute)." << endl;
+    }
+    
     return 0;
 }
\ No newline at end of file
@@ -9,82 +9,92 @@
 #include <algorithm>
 #include <limits>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#include <cstdint>
 
 using namespace std;
 
 class OptimalPageReplacement {
 private:
+    static constexpr uint32_t NEVER = numeric_limits<uint32_t>::max();
+    
     int numFrames;
-    vector<int> frames;
-    int pageFaults;
-    const vector<int>* refString;  // Pointer to reference string
+    long long pageFaults;
+    unordered_set<int> resident;            // Pages currently in frames
     
-    bool isPageInMemory(int page) {
-        return find(frames.begin(), frames.end(), page) != frames.end();
+    // Max-heap of (next use, page) for resident pages. A hit pushes a new
+    // entry instead of updating the old one; stale entries are recognised
+    // because their next use is already in the past.
+    vector<pair<uint32_t, int>> victims;
+    
+    // Next use of each reference in one reverse pass
+    static vector<uint32_t> computeNextUse(const vector<int>& refString) {
+        vector<uint32_t> nextUse(refString.size());
+        unordered_map<int, uint32_t> upcoming;
+        for (size_t i = refString.size(); i-- > 0;) {
+            auto it = upcoming.find(refString[i]);
+            if (it == upcoming.end()) {
+                nextUse[i] = NEVER;
+                upcoming.emplace(refString[i], static_cast<uint32_t>(i));
+            } else {
+                nextUse[i] = it->second;
+                it->second = static_cast<uint32_t>(i);
+            }
+        }
+        return nextUse;
     }
     
-    int findEmptyFrame() {
-        for (int i = 0; i < numFrames; i++) {
-            if (frames[i] == -1) return i;
+    void pushVictim(uint32_t nextUse, int page, uint32_t now) {
+        // Drop stale entries once they outnumber the live ones
+        if (victims.size() > 2 * static_cast<size_t>(numFrames) + 64) {
+            victims.erase(remove_if(victims.begin(), victims.end(),
+                                    [now](const pair<uint32_t, int>& v) { return v.first <= now; }),
+                          victims.end());
+            make_heap(victims.begin(), victims.end());
         }
-        return -1;
+        victims.push_back({nextUse, page});
+        push_heap(victims.begin(), victims.end());
     }
     
-    // Find page that will not be used for longest time
-    int findOptimalVictim(int currentIndex) {
-        int victimIndex = -1;
-        int farthest = currentIndex;
-        
-        for (int i = 0; i < numFrames; i++) {
-            int page = frames[i];
-            
-            // Find next use of this page
-            int nextUse = numeric_limits<int>::max();
-            for (int j = currentIndex + 1; j < refString->size(); j++) {
-                if ((*refString)[j] == page) {
-                    nextUse = j;
-                    break;
-                }
-            }
-            
-            // Replace page that won't be used for longest time
-            if (nextUse > farthest) {
-                farthest = nextUse;
-                victimIndex = i;
-            }
+    // Resident page that will not be used for the longest time
+    int popOptimalVictim(uint32_t now) {
+        while (true) {
+            pop_heap(victims.begin(), victims.end());
+            pair<uint32_t, int> top = victims.back();
+            victims.pop_back();
+            if (top.first > now) return top.second;
         }
-        
-        return victimIndex;
     }
     
 public:
-    OptimalPageReplacement(int frames) : numFrames(frames), pageFaults(0) {
-        this->frames.resize(frames, -1);
-    }
+    OptimalPageReplacement(int frames) : numFrames(frames), pageFaults(0) {}
     
     void processReferenceString(const vector<int>& refStr) {
-        refString = &refStr;
-        frames.assign(numFrames, -1);
+        vector<uint32_t> nextUse = computeNextUse(refStr);
+        resident.clear();
+        resident.reserve(numFrames * 2);
+        victims.clear();
         pageFaults = 0;
         
-        for (int i = 0; i < refStr.size(); i++) {
+        for (size_t i = 0; i < refStr.size(); i++) {
             int page = refStr[i];
+            uint32_t now = static_cast<uint32_t>(i);
             
-            if (!isPageInMemory(page)) {
+            if (resident.count(page) == 0) {
                 pageFaults++;
                 
-                int emptyFrame = findEmptyFrame();
-                if (emptyFrame != -1) {
-                    frames[emptyFrame] = page;
-                } else {
-                    int victimIndex = findOptimalVictim(i);
-                    frames[victimIndex] = page;
+                if (static_cast<int>(resident.size()) == numFrames) {
+                    resident.erase(popOptimalVictim(now));
                 }
+                resident.insert(page);
             }
+            pushVictim(nextUse[i], page, now);
         }
     }
     
-    int getPageFaults() const { return pageFaults; }
+    long long getPageFaults() const { return pageFaults; }
 };
 
 class FIFOPageReplacement {
@@ -212,6 +222,524 @@ public:
     int getPageFaults() const { return pageFaults; }
 };
 
+// Disk and memory costs as modelled in Lab9-6, in microseconds
+const int DISK_ACCESS_TIME = 1000;
+const int MEMORY_ACCESS_TIME = 1;
+
+// Quiet, high-throughput FIFO/LRU simulator for very long traces. Resident
+// pages are found through an open-addressing hash (page -> frame) instead
+// of scanning the frames, LRU order is an intrusive doubly linked list over
+// frame slots, and FIFO order is a ring: frames fill in order and every
+// replacement reuses the slot after the previous one, so the ring hand
+// always points at the oldest page.
+class PageReplacementEngine {
+public:
+    enum Policy { FIFO, LRU };
+    
+private:
+    static constexpr int EMPTY = -1;
+    
+    struct HashSlot {
+        int page;
+        int frame;
+    };
+    
+    Policy policy;
+    int numFrames;
+    int usedFrames;
+    vector<int> framePage;              // Page held by each frame
+    vector<char> frameDirty;            // PageTableEntry::dirty of each frame's page
+    int dirtyFrames;
+    vector<int> prevFrame, nextFrame;   // LRU list, head = most recently used
+    int lruHead, lruTail;
+    int fifoHand;                       // Next FIFO victim
+    
+    vector<HashSlot> table;             // Resident pages, linear probing
+    unsigned int hashMask;
+    int hashShift;
+    
+    long long references;
+    long long hits;
+    long long faults;
+    long long evictions;
+    long long writes;
+    long long writeBacks;               // Dirty victims written on the fault path
+    long long flushedPages;             // Dirty pages cleaned by the flusher
+    
+    int flushInterval;                  // References between flusher runs, 0 = off
+    int flushBatch;                     // Pages cleaned per run at most
+    int sinceFlush;
+    
+    // Fibonacci hashing: top bits of page * 2^32/phi
+    unsigned int home(int page) const {
+        return (static_cast<unsigned int>(page) * 2654435769u) >> hashShift;
+    }
+    
+    int lookup(int page) const {
+        for (unsigned int i = home(page); ; i = (i + 1) & hashMask) {
+            if (table[i].page == page) return table[i].frame;
+            if (table[i].page == EMPTY) return EMPTY;
+        }
+    }
+    
+    void insert(int page, int frame) {
+        unsigned int i = home(page);
+        while (table[i].page != EMPTY) {
+            i = (i + 1) & hashMask;
+        }
+        table[i] = {page, frame};
+    }
+    
+    // Backward-shift deletion keeps probe chains intact without tombstones
+    void erase(int page) {
+        unsigned int i = home(page);
+        while (table[i].page != page) {
+            i = (i + 1) & hashMask;
+        }
+        for (unsigned int j = (i + 1) & hashMask; table[j].page != EMPTY; j = (j + 1) & hashMask) {
+            unsigned int k = home(table[j].page);
+            bool movable = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+            if (movable) {
+                table[i] = table[j];
+                i = j;
+            }
+        }
+        table[i].page = EMPTY;
+    }
+    
+    void unlink(int frame) {
+        int prev = prevFrame[frame], next = nextFrame[frame];
+        if (prev != EMPTY) nextFrame[prev] = next; else lruHead = next;
+        if (next != EMPTY) prevFrame[next] = prev; else lruTail = prev;
+    }
+    
+    void pushFront(int frame) {
+        prevFrame[frame] = EMPTY;
+        nextFrame[frame] = lruHead;
+        if (lruHead != EMPTY) prevFrame[lruHead] = frame; else lruTail = frame;
+        lruHead = frame;
+    }
+    
+    void markDirty(int frame) {
+        if (!frameDirty[frame]) {
+            frameDirty[frame] = 1;
+            dirtyFrames++;
+        }
+    }
+    
+    // Background flusher: writes back dirty pages closest to eviction so
+    // that victims are usually clean by the time a fault needs their frame.
+    // Scans at most 4 * flushBatch frames from the victim end.
+    void flush() {
+        sinceFlush = 0;
+        int frame = (policy == LRU) ? lruTail : fifoHand;
+        int cleaned = 0;
+        for (int scanned = 0; frame != EMPTY && scanned < min(usedFrames, 4 * flushBatch)
+                              && cleaned < flushBatch && dirtyFrames > 0; scanned++) {
+            if (frameDirty[frame]) {
+                frameDirty[frame] = 0;
+                dirtyFrames--;
+                flushedPages++;
+                cleaned++;
+            }
+            if (policy == LRU) {
+                frame = prevFrame[frame];
+            } else {
+                frame = (frame + 1 == usedFrames) ? 0 : frame + 1;
+            }
+        }
+    }
+    
+public:
+    PageReplacementEngine(int frames, Policy p) 
+        : policy(p), numFrames(frames), flushInterval(0), flushBatch(0) {
+        // At most 25% load: hits almost always resolve on the first probe
+        int bits = 4;
+        while ((1 << bits) < 4 * frames) bits++;
+        table.resize(1u << bits);
+        hashMask = (1u << bits) - 1;
+        hashShift = 32 - bits;
+        
+        framePage.resize(frames);
+        frameDirty.resize(frames);
+        prevFrame.resize(frames);
+        nextFrame.resize(frames);
+        reset();
+    }
+    
+    void reset() {
+        for (auto& slot : table) slot.page = EMPTY;
+        framePage.assign(numFrames, EMPTY);
+        frameDirty.assign(numFrames, 0);
+        dirtyFrames = 0;
+        usedFrames = 0;
+        lruHead = lruTail = EMPTY;
+        fifoHand = 0;
+        references = hits = faults = evictions = 0;
+        writes = writeBacks = flushedPages = 0;
+        sinceFlush = 0;
+    }
+    
+    // Runs the dirty-page flusher every interval references, cleaning up
+    // to batch pages per run; interval 0 turns it off
+    void setFlusher(int interval, int batch) {
+        flushInterval = interval;
+        flushBatch = batch;
+        sinceFlush = 0;
+    }
+    
+    void reference(int page) {
+        reference(page, false);
+    }
+    
+    void reference(int page, bool write) {
+        references++;
+        int frame = lookup(page);
+        
+        if (frame != EMPTY) {
+            hits++;
+            if (policy == LRU && frame != lruHead) {
+                unlink(frame);
+                pushFront(frame);
+            }
+        } else {
+            frame = load(page);
+        }
+        
+        if (write) {
+            writes++;
+            markDirty(frame);
+        }
+        if (flushInterval != 0 && ++sinceFlush == flushInterval) {
+            flush();
+        }
+    }
+    
+    // Fault path: takes a free frame or the policy's victim, writing the
+    // victim back first if it is dirty
+    int load(int page) {
+        int frame;
+        faults++;
+        if (usedFrames < numFrames) {
+            frame = usedFrames++;
+        } else {
+            evictions++;
+            if (policy == FIFO) {
+                frame = fifoHand;
+                fifoHand = (fifoHand + 1 == numFrames) ? 0 : fifoHand + 1;
+            } else {
+                frame = lruTail;
+                unlink(frame);
+            }
+            erase(framePage[frame]);
+            if (frameDirty[frame]) {
+                writeBacks++;
+                frameDirty[frame] = 0;
+                dirtyFrames--;
+            }
+        }
+        
+        framePage[frame] = page;
+        insert(page, frame);
+        if (policy == LRU) pushFront(frame);
+        return frame;
+    }
+    
+    void processBlock(const int* refs, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            reference(refs[i]);
+        }
+    }
+    
+    // writes[i] != 0 marks refs[i] as a store
+    void processBlock(const int* refs, const char* writes, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            reference(refs[i], writes[i] != 0);
+        }
+    }
+    
+    void processReferenceString(const vector<int>& refString) {
+        processBlock(refString.data(), refString.size());
+    }
+    
+    // Streams a trace through a fixed buffer: fill(buffer, max) writes up
+    // to max references and returns how many, 0 at the end of the trace
+    template <typename Source>
+    void processStream(Source& fill, size_t blockSize = 1 << 16) {
+        vector<int> block(blockSize);
+        size_t count;
+        while ((count = fill(block.data(), blockSize)) > 0) {
+            processBlock(block.data(), count);
+        }
+    }
+    
+    long long getReferences() const { return references; }
+    long long getHits() const { return hits; }
+    long long getPageFaults() const { return faults; }
+    long long getEvictions() const { return evictions; }
+    long long getReads() const { return references - writes; }
+    long long getWrites() const { return writes; }
+    long long getWriteBacks() const { return writeBacks; }
+    long long getFlushedPages() const { return flushedPages; }
+    
+    // Average time per reference in microseconds: every reference touches
+    // memory, every fault reads the page from disk, and a dirty victim adds
+    // a disk write before the read. Flusher writes happen in the background
+    // and do not stall references.
+    double getEffectiveAccessTime() const {
+        if (references == 0) return 0.0;
+        return MEMORY_ACCESS_TIME + 
+               static_cast<double>(faults + writeBacks) * DISK_ACCESS_TIME / references;
+    }
+    
+    void displayStatistics() const {
+        cout << (policy == FIFO ? "FIFO" : "LRU") << ": References: " << references
+             << ", Hits: " << hits << ", Faults: " << faults << ", Evictions: " << evictions
+             << ", Fault Rate: " << fixed << setprecision(4) 
+             << (references ? faults * 100.0 / references : 0.0) << "%" << endl;
+        if (writes > 0) {
+            cout << "  Reads: " << getReads() << ", Writes: " << writes 
+                 << ", Write-backs: " << writeBacks << ", Flushed: " << flushedPages
+                 << ", EAT: " << setprecision(2) << getEffectiveAccessTime() << " us" << endl;
+        }
+    }
+};
+
+// Fenwick (binary indexed) tree of counts: point update, prefix sum
+class FenwickTree {
+private:
+    vector<int> tree;
+    
+public:
+    explicit FenwickTree(size_t size = 0) : tree(size + 1, 0) {}
+    
+    size_t size() const { return tree.size() - 1; }
+    
+    void add(size_t index, int delta) {  // index is 1-based
+        for (; index < tree.size(); index += index & (~index + 1)) {
+            tree[index] += delta;
+        }
+    }
+    
+    long long prefix(size_t index) const {
+        long long sum = 0;
+        for (; index > 0; index -= index & (~index + 1)) {
+            sum += tree[index];
+        }
+        return sum;
+    }
+};
+
+// Mattson stack-distance analysis for LRU: one pass gives the fault count
+// for every number of frames. The stack distance of a reference is the
+// number of distinct pages touched since the previous reference to the
+// same page; with k frames it faults exactly when that distance exceeds k.
+// Distinct pages are counted with a Fenwick tree holding a 1 at each
+// page's last access time, so a reference costs O(log n). Times are
+// renumbered when the tree fills up, so arbitrarily long traces fit.
+class LRUStackDistance {
+private:
+    FenwickTree marks;
+    unordered_map<int, uint32_t> lastAccess;
+    vector<long long> histogram;    // histogram[d]: references at distance d;
+                                    // the last bucket collects everything deeper
+    uint32_t now;
+    long long references;
+    long long coldMisses;
+    
+    // Renumbers live access times 1..m in order; grows the tree if it
+    // would be more than half full afterwards
+    void compact() {
+        vector<pair<uint32_t, int>> live;
+        live.reserve(lastAccess.size());
+        for (const auto& entry : lastAccess) {
+            live.push_back({entry.second, entry.first});
+        }
+        sort(live.begin(), live.end());
+        
+        size_t capacity = marks.size();
+        while (live.size() * 2 > capacity) capacity *= 2;
+        marks = FenwickTree(capacity);
+        
+        now = 0;
+        for (const auto& entry : live) {
+            lastAccess[entry.second] = ++now;
+            marks.add(now, 1);
+        }
+    }
+    
+public:
+    LRUStackDistance(int maxDistance = 1 << 16, size_t timeWindow = 1 << 20)
+        : marks(timeWindow), histogram(maxDistance + 2, 0), now(0), references(0), coldMisses(0) {}
+    
+    void reference(int page) {
+        references++;
+        if (now == marks.size()) compact();
+        now++;
+        
+        auto it = lastAccess.find(page);
+        if (it == lastAccess.end()) {
+            coldMisses++;
+            lastAccess.emplace(page, now);
+        } else {
+            uint32_t previous = it->second;
+            long long distance = static_cast<long long>(lastAccess.size()) - marks.prefix(previous) + 1;
+            histogram[min<long long>(distance, histogram.size() - 1)]++;
+            marks.add(previous, -1);
+            it->second = now;
+        }
+        marks.add(now, 1);
+    }
+    
+    void processReferenceString(const vector<int>& refString) {
+        for (int page : refString) {
+            reference(page);
+        }
+    }
+    
+    // LRU page faults with the given number of frames (up to maxDistance)
+    long long getPageFaults(int frames) const {
+        long long faults = coldMisses;
+        for (size_t d = frames + 1; d < histogram.size(); d++) {
+            faults += histogram[d];
+        }
+        return faults;
+    }
+    
+    long long getReferences() const { return references; }
+    int getMaxDistance() const { return static_cast<int>(histogram.size()) - 2; }
+};
+
+// Mattson's priority stack for OPT: the referenced page goes on top and
+// each level below keeps whichever of (carried page, resident page) is
+// referenced sooner. OPT with k frames holds exactly the top k pages, so
+// one pass yields the OPT fault count for every k up to maxFrames. Needs
+// the whole trace (next-use times) and costs O(stack distance) per
+// reference, capped at maxFrames.
+class OPTStackDistance {
+private:
+    vector<long long> histogram;    // histogram[d], d = maxFrames + 1 means deeper
+    long long coldMisses;
+    
+public:
+    explicit OPTStackDistance(int maxFrames) : histogram(maxFrames + 2, 0), coldMisses(0) {}
+    
+    void processReferenceString(const vector<int>& refString) {
+        const long long NEVER = numeric_limits<long long>::max();
+        int maxFrames = static_cast<int>(histogram.size()) - 2;
+        
+        // Next use of each reference, from a backward pass
+        vector<long long> nextUse(refString.size());
+        unordered_map<int, long long> upcoming;
+        for (size_t i = refString.size(); i-- > 0;) {
+            auto it = upcoming.find(refString[i]);
+            nextUse[i] = (it == upcoming.end()) ? NEVER : it->second;
+            upcoming[refString[i]] = i;
+        }
+        
+        unordered_map<int, bool> seen;
+        vector<int> stackPages;         // top of stack first, at most maxFrames deep
+        vector<long long> stackNext;
+        
+        for (size_t i = 0; i < refString.size(); i++) {
+            int page = refString[i];
+            
+            size_t depth = 0;
+            while (depth < stackPages.size() && stackPages[depth] != page) depth++;
+            bool found = depth < stackPages.size();
+            
+            if (!seen[page]) {
+                seen[page] = true;
+                coldMisses++;
+            } else {
+                histogram[found ? depth + 1 : maxFrames + 1]++;
+            }
+            
+            if (found && depth == 0) {
+                stackNext[0] = nextUse[i];
+                continue;
+            }
+            
+            // Push the page on top and carry the old top down to where
+            // the page was (or to the bottom)
+            int carryPage = page;
+            long long carryNext = nextUse[i];
+            size_t end = found ? depth : stackPages.size();
+            for (size_t level = 0; level < end; level++) {
+                if (level == 0 || carryNext < stackNext[level]) {
+                    swap(stackPages[level], carryPage);
+                    swap(stackNext[level], carryNext);
+                }
+            }
+            if (found) {
+                stackPages[depth] = carryPage;
+                stackNext[depth] = carryNext;
+            } else if (stackPages.size() < static_cast<size_t>(maxFrames)) {
+                stackPages.push_back(carryPage);
+                stackNext.push_back(carryNext);
+            }
+        }
+    }
+    
+    long long getPageFaults(int frames) const {
+        long long faults = coldMisses;
+        for (size_t d = frames + 1; d < histogram.size(); d++) {
+            faults += histogram[d];
+        }
+        return faults;
+    }
+};
+
+// SHARDS (spatially hashed sampling): only pages whose hash falls below a
+// threshold are analysed, i.e. a fixed fraction R of the page space. The
+// d - 1 sampled pages between two uses of a page stand for (d - 1) / R
+// pages of the full trace and every sampled fault for 1 / R faults, so the
+// curve is read back scaled. Only frame counts well above 1 / R are
+// resolved; smaller caches see too few sampled pages.
+class ShardsSampler {
+private:
+    LRUStackDistance analyzer;
+    uint32_t threshold;             // sample if hash < threshold (24-bit)
+    double rate;
+    long long references;
+    
+    static uint32_t hashPage(int page) {
+        uint32_t h = static_cast<uint32_t>(page);
+        h ^= h >> 16;
+        h *= 0x7feb352du;
+        h ^= h >> 15;
+        h *= 0x846ca68bu;
+        h ^= h >> 16;
+        return h & 0xFFFFFFu;
+    }
+    
+public:
+    ShardsSampler(double samplingRate, int maxDistance = 1 << 16)
+        : analyzer(maxDistance), threshold(static_cast<uint32_t>(samplingRate * (1u << 24))),
+          rate(samplingRate), references(0) {}
+    
+    void reference(int page) {
+        references++;
+        if (hashPage(page) < threshold) analyzer.reference(page);
+    }
+    
+    void processBlock(const int* refs, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            reference(refs[i]);
+        }
+    }
+    
+    // Estimated LRU faults for the full trace
+    double getPageFaults(int frames) const {
+        // Full-trace distance (d - 1) / R + 1 exceeds frames
+        int sampledFrames = min(static_cast<int>((frames - 1) * rate) + 1, analyzer.getMaxDistance());
+        return analyzer.getPageFaults(sampledFrames) / rate;
+    }
+    
+    long long getReferences() const { return references; }
+    long long getSampledReferences() const { return analyzer.getReferences(); }
+};
+
 void compareAlgorithms(const vector<int>& refString, int numFrames) {
     cout << "\n=== Comparison Report ===" << endl;
     cout << "Reference String: ";
@@ -265,7 +793,205 @@ void compareAlgorithms(const vector<int>& refString, int numFrames) {
     }
 }
 
-int main() {
+// Reference generator with locality: 95% of references fall in a 64-page
+// working set that moves every million references, the rest are uniform
+// over a million pages
+class LocalityTrace {
+private:
+    long long remaining;
+    long long position;
+    uint32_t state;
+    
+public:
+    LocalityTrace(long long length, uint32_t seed = 2463534242u) 
+        : remaining(length), position(0), state(seed) {}
+    
+    size_t operator()(int* buffer, size_t max) {
+        size_t count = static_cast<size_t>(min<long long>(remaining, static_cast<long long>(max)));
+        for (size_t i = 0; i < count; i++, position++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            int base = static_cast<int>((position >> 20) * 64 % 1000000);
+            buffer[i] = (state % 100 < 95) ? base + static_cast<int>(state >> 26) 
+                                           : static_cast<int>((state >> 8) % 1000000);
+        }
+        remaining -= count;
+        return count;
+    }
+};
+
+// Streams one trace through FIFO and LRU engines side by side, block by block
+void benchmarkEngine(long long numReferences, int numFrames) {
+    cout << "\n\n*** Engine Benchmark: " << numReferences << " references, " 
+         << numFrames << " frames ***" << endl;
+    
+    PageReplacementEngine fifo(numFrames, PageReplacementEngine::FIFO);
+    PageReplacementEngine lru(numFrames, PageReplacementEngine::LRU);
+    LocalityTrace trace(numReferences);
+    
+    const size_t blockSize = 1 << 16;
+    vector<int> block(blockSize);
+    double fifoSeconds = 0, lruSeconds = 0;
+    size_t count;
+    while ((count = trace(block.data(), blockSize)) > 0) {
+        auto start = chrono::steady_clock::now();
+        fifo.processBlock(block.data(), count);
+        auto middle = chrono::steady_clock::now();
+        lru.processBlock(block.data(), count);
+        auto end = chrono::steady_clock::now();
+        fifoSeconds += chrono::duration<double>(middle - start).count();
+        lruSeconds += chrono::duration<double>(end - middle).count();
+    }
+    
+    fifo.displayStatistics();
+    cout << "  " << setprecision(2) << fifoSeconds << " s, " 
+         << setprecision(1) << numReferences / fifoSeconds / 1e6 << "M refs/s" << endl;
+    lru.displayStatistics();
+    cout << "  " << setprecision(2) << lruSeconds << " s, " 
+         << setprecision(1) << numReferences / lruSeconds / 1e6 << "M refs/s" << endl;
+}
+
+// Write-back cost: the same trace with 30% stores, with and without the
+// background flusher. Fault counts match; the stall time does not.
+void benchmarkWriteBack(long long numReferences, int numFrames) {
+    cout << "\n\n*** Dirty-Page Write-Back: " << numReferences << " references, " 
+         << numFrames << " frames, 30% writes ***" << endl;
+    
+    PageReplacementEngine engines[] = {
+        PageReplacementEngine(numFrames, PageReplacementEngine::FIFO),
+        PageReplacementEngine(numFrames, PageReplacementEngine::LRU),
+        PageReplacementEngine(numFrames, PageReplacementEngine::FIFO),
+        PageReplacementEngine(numFrames, PageReplacementEngine::LRU)
+    };
+    engines[2].setFlusher(256, 32);
+    engines[3].setFlusher(256, 32);
+    
+    LocalityTrace trace(numReferences);
+    const size_t blockSize = 1 << 16;
+    vector<int> block(blockSize);
+    vector<char> writes(blockSize);
+    uint32_t state = 88675123u;
+    size_t count;
+    while ((count = trace(block.data(), blockSize)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            writes[i] = (state % 10 < 3);
+        }
+        for (auto& engine : engines) {
+            engine.processBlock(block.data(), writes.data(), count);
+        }
+    }
+    
+    cout << "\n" << left << setw(16) << "Engine" << setw(12) << "Faults" << setw(14) << "Write-backs"
+         << setw(12) << "Flushed" << setw(16) << "Disk Writes" << "EAT (us)" << endl;
+    cout << string(78, '-') << endl;
+    const char* names[] = {"FIFO", "LRU", "FIFO + flusher", "LRU + flusher"};
+    for (int i = 0; i < 4; i++) {
+        const PageReplacementEngine& engine = engines[i];
+        cout << left << setw(16) << names[i] << setw(12) << engine.getPageFaults()
+             << setw(14) << engine.getWriteBacks() << setw(12) << engine.getFlushedPages()
+             << setw(16) << engine.getWriteBacks() + engine.getFlushedPages()
+             << fixed << setprecision(2) << engine.getEffectiveAccessTime() << endl;
+    }
+    cout << "Fault-only estimate (LRU): " << MEMORY_ACCESS_TIME + 
+            static_cast<double>(engines[1].getPageFaults()) * DISK_ACCESS_TIME / numReferences 
+         << " us" << endl;
+}
+
+// OPT as a baseline on a long trace, next to LRU with the same frames
+void benchmarkOptimal(long long numReferences, int numFrames) {
+    cout << "\n\n*** Optimal Baseline: " << numReferences << " references, " 
+         << numFrames << " frames ***" << endl;
+    
+    vector<int> refString(numReferences);
+    LocalityTrace trace(numReferences);
+    trace(refString.data(), refString.size());
+    
+    // Cross-check against the stack-distance pass on a prefix
+    vector<int> prefix(refString.begin(), refString.begin() + min<long long>(numReferences, 1000000));
+    OptimalPageReplacement prefixOpt(64);
+    prefixOpt.processReferenceString(prefix);
+    OPTStackDistance prefixStack(64);
+    prefixStack.processReferenceString(prefix);
+    
+    auto start = chrono::steady_clock::now();
+    OptimalPageReplacement opt(numFrames);
+    opt.processReferenceString(refString);
+    auto end = chrono::steady_clock::now();
+    
+    PageReplacementEngine lru(numFrames, PageReplacementEngine::LRU);
+    lru.processReferenceString(refString);
+    
+    cout << "Optimal: " << opt.getPageFaults() << " faults (" << fixed << setprecision(4)
+         << opt.getPageFaults() * 100.0 / numReferences << "%), " << setprecision(2)
+         << chrono::duration<double>(end - start).count() << " s" << endl;
+    cout << "LRU:     " << lru.getPageFaults() << " faults (" << setprecision(4)
+         << lru.getPageFaults() * 100.0 / numReferences << "%)" << endl;
+    cout << "Optimal on the first " << prefix.size() << " references with 64 frames "
+         << (prefixOpt.getPageFaults() == prefixStack.getPageFaults(64) ? "matches" : "DIFFERS FROM")
+         << " the stack-distance pass" << endl;
+}
+
+// Exact LRU curve vs SHARDS on a prefix, then SHARDS alone on a trace too
+// long to analyse exactly
+void benchmarkMissRatioCurves(long long exactReferences, long long sampledReferences) {
+    cout << "\n\n*** One-Pass LRU Miss-Ratio Curve: " << exactReferences << " references ***" << endl;
+    const int frameCounts[] = {64, 128, 256, 512, 1024, 2048, 4096, 8192};
+    const size_t blockSize = 1 << 16;
+    vector<int> block(blockSize);
+    size_t count;
+    
+    LRUStackDistance exact(1 << 14);
+    ShardsSampler shards(0.01, 1 << 14);
+    PageReplacementEngine check(1024, PageReplacementEngine::LRU);
+    LocalityTrace trace(exactReferences);
+    
+    auto start = chrono::steady_clock::now();
+    while ((count = trace(block.data(), blockSize)) > 0) {
+        for (size_t i = 0; i < count; i++) exact.reference(block[i]);
+        shards.processBlock(block.data(), count);
+        check.processBlock(block.data(), count);
+    }
+    auto end = chrono::steady_clock::now();
+    
+    cout << left << setw(10) << "Frames" << setw(16) << "Exact LRU" << setw(16) << "SHARDS 1%" 
+         << setw(12) << "Error" << endl;
+    cout << string(54, '-') << endl;
+    for (int frames : frameCounts) {
+        double exactRatio = exact.getPageFaults(frames) * 100.0 / exactReferences;
+        double sampledRatio = shards.getPageFaults(frames) * 100.0 / exactReferences;
+        cout << left << setw(10) << frames << fixed << setprecision(4)
+             << setw(16) << exactRatio << setw(16) << sampledRatio 
+             << setw(12) << (sampledRatio - exactRatio) << endl;
+    }
+    cout << "8 frame counts from one pass in " << setprecision(2) 
+         << chrono::duration<double>(end - start).count() << " s; LRU simulation at 1024 frames "
+         << (check.getPageFaults() == exact.getPageFaults(1024) ? "agrees" : "DISAGREES") << endl;
+    
+    cout << "\n*** SHARDS 0.1% on " << sampledReferences << " references ***" << endl;
+    ShardsSampler longRun(0.001, 1 << 14);
+    LocalityTrace longTrace(sampledReferences, 12345);
+    start = chrono::steady_clock::now();
+    while ((count = longTrace(block.data(), blockSize)) > 0) {
+        longRun.processBlock(block.data(), count);
+    }
+    end = chrono::steady_clock::now();
+    
+    for (int frames : frameCounts) {
+        cout << left << setw(10) << frames << setprecision(4) 
+             << longRun.getPageFaults(frames) * 100.0 / sampledReferences << "%" << endl;
+    }
+    cout << longRun.getSampledReferences() << " references sampled, " << setprecision(2)
+         << chrono::duration<double>(end - start).count() << " s" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    // The long benchmarks run on request
+    bool runBenchmarks = argc > 1 && string(argv[1]) == "--benchmark";
+    
     cout << "=== Optimal Page Replacement Algorithm ===" << endl;
     
     // Test case 1: Standard comparison
@@ -328,5 +1054,67 @@ int main() {
     cout << "\nOptimal is used as a benchmark to evaluate practical algorithms." << endl;
     cout << "LRU approximates Optimal by assuming past behavior predicts future." << endl;
     
+    // Test case 7: the engine must agree with the reference implementations
+    cout << "\n\n*** Test 7: Engine vs Reference Implementations ***" << endl;
+    bool agree = true;
+    for (const vector<int>* refString : {&refString1, &refString2, &refString3, &refString4, &refString5}) {
+        for (int frames = 1; frames <= 6; frames++) {
+            FIFOPageReplacement fifo(frames);
+            fifo.processReferenceString(*refString);
+            PageReplacementEngine fastFifo(frames, PageReplacementEngine::FIFO);
+            fastFifo.processReferenceString(*refString);
+            
+            LRUPageReplacement lru(frames);
+            lru.processReferenceString(*refString);
+            PageReplacementEngine fastLru(frames, PageReplacementEngine::LRU);
+            fastLru.processReferenceString(*refString);
+            
+            agree = agree && fifo.getPageFaults() == fastFifo.getPageFaults()
+                          && lru.getPageFaults() == fastLru.getPageFaults();
+        }
+    }
+    cout << "FIFO/LRU engine fault counts " << (agree ? "match" : "DIFFER FROM") 
+         << " the reference implementations" << endl;
+    
+    // Test 8: every frame count from a single pass
+    cout << "\n\n*** Test 8: One-Pass Stack-Distance Analysis ***" << endl;
+    LRUStackDistance lruCurve;
+    lruCurve.processReferenceString(refString5);
+    OPTStackDistance optCurve(6);
+    optCurve.processReferenceString(refString5);
+    
+    cout << "\n" << left << setw(10) << "Frames" << setw(12) << "Optimal" << setw(12) << "LRU" << endl;
+    cout << string(34, '-') << endl;
+    bool curvesAgree = true;
+    for (int frames = 2; frames <= 6; frames++) {
+        cout << left << setw(10) << frames << setw(12) << optCurve.getPageFaults(frames)
+             << setw(12) << lruCurve.getPageFaults(frames) << endl;
+    }
+    for (const vector<int>* refString : {&refString1, &refString2, &refString3, &refString4, &refString5}) {
+        LRUStackDistance lruStack;
+        lruStack.processReferenceString(*refString);
+        OPTStackDistance optStack(6);
+        optStack.processReferenceString(*refString);
+        for (int frames = 1; frames <= 6; frames++) {
+            LRUPageReplacement lru(frames);
+            lru.processReferenceString(*refString);
+            OptimalPageReplacement opt(frames);
+            opt.processReferenceString(*refString);
+            curvesAgree = curvesAgree && lru.getPageFaults() == lruStack.getPageFaults(frames)
+                                      && opt.getPageFaults() == optStack.getPageFaults(frames);
+        }
+    }
+    cout << "Single-pass curves " << (curvesAgree ? "match" : "DIFFER FROM")
+         << " per-frame-count simulation (1-6 frames, all test strings)" << endl;
+    
+    if (runBenchmarks) {
+        benchmarkEngine(1000000000LL, 1024);
+        benchmarkOptimal(100000000LL, 1024);
+        benchmarkWriteBack(20000000LL, 1024);
+        benchmarkMissRatioCurves(20000000LL, 2000000000LL);
+    } else {
+        cout << "\nRun with --benchmark for the engine, OPT, write-back and miss-ratio-curve benchmarks (about a minute, 1 GB of RAM)." << endl;
+    }
+    
     return 0;
 }
\ No newline at end of file